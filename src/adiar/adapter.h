@@ -4,6 +4,7 @@
 #include <string_view>
 
 #include "../common/adapter.h"
+#include "../common/satcount.h"
 
 #include <adiar/adiar.h>
 
@@ -63,6 +64,11 @@ public:
 
   static constexpr bool complement_edges = false;
 
+  static constexpr bool thread_safe      = false;
+  static constexpr bool supports_rename  = true;
+  static constexpr bool supports_relnext = true;
+  static constexpr bool exact_satcount   = false;
+
 public:
   using dd_t   = adiar::bdd;
   using __dd_t = adiar::__bdd;
@@ -236,6 +242,15 @@ public:
       adiar::replace_type::Shift);
   }
 
+  inline adiar::bdd
+  rename(const adiar::bdd& f, const std::function<int(int)>& m)
+  {
+    return adiar::bdd_replace(
+      f,
+      [&m](const adiar::bdd::label_type x) -> adiar::bdd::label_type { return m(x); },
+      adiar::replace_type::Monotone);
+  }
+
   inline uint64_t
   nodecount(const adiar::bdd& f)
   {
@@ -269,6 +284,19 @@ public:
     return adiar::bdd_satcount(f, vc);
   }
 
+  inline big_uint
+  satcount_exact(const adiar::bdd& f)
+  {
+    return this->satcount_exact(f, this->_varcount);
+  }
+
+  inline big_uint
+  satcount_exact(const adiar::bdd& f, const size_t vc)
+  {
+    // Adiar's nodes only live in (external memory) streams; the count is limited to 64 bits.
+    return adiar::bdd_satcount(f, vc);
+  }
+
   inline std::vector<std::pair<int, char>>
   pickcube(const adiar::bdd& f)
   {
@@ -329,6 +357,11 @@ public:
   static constexpr bool needs_extend     = true;
   static constexpr bool complement_edges = false;
 
+  static constexpr bool thread_safe      = false;
+  static constexpr bool supports_rename  = false;
+  static constexpr bool supports_relnext = false;
+  static constexpr bool exact_satcount   = false;
+
 public:
   using dd_t   = adiar::zdd;
   using __dd_t = adiar::__zdd;
@@ -491,6 +524,19 @@ public:
     return adiar::zdd_size(f);
   }
 
+  inline big_uint
+  satcount_exact(const adiar::zdd& f)
+  {
+    return this->satcount_exact(f, this->_varcount);
+  }
+
+  inline big_uint
+  satcount_exact(const adiar::zdd& f, const size_t /*vc*/)
+  {
+    // Adiar's nodes only live in (external memory) streams; the count is limited to 64 bits.
+    return adiar::zdd_size(f);
+  }
+
   inline std::vector<std::pair<int, char>>
   pickcube(const adiar::zdd& f)
   {
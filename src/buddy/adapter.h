@@ -8,6 +8,7 @@
 #include <string_view>
 
 #include "../common/adapter.h"
+#include "../common/satcount.h"
 
 #include <bdd.h>
 
@@ -103,6 +104,11 @@ public:
 
   static constexpr bool complement_edges = false;
 
+  static constexpr bool thread_safe      = false;
+  static constexpr bool supports_rename  = true;
+  static constexpr bool supports_relnext = true;
+  static constexpr bool exact_satcount   = true;
+
 public:
   typedef bdd dd_t;
   typedef bdd build_node_t;
@@ -332,6 +338,21 @@ public:
     return bdd_appex(bdd_replace(states, _pairs_relprev), rel, bddop_and, _vars_relprev);
   }
 
+  inline bdd
+  rename(const bdd& f, const std::function<int(int)>& m)
+  {
+    assert(is_variable_permutation(_varcount, m));
+
+    bddPair* pairs = bdd_newpair();
+    for (int x = 0; x < _varcount; ++x) {
+      if (m(x) != x) { bdd_setpair(pairs, x, m(x)); }
+    }
+
+    const bdd res = bdd_replace(f, pairs);
+    bdd_freepair(pairs);
+    return res;
+  }
+
   inline uint64_t
   nodecount(const bdd& f)
   {
@@ -356,6 +377,61 @@ public:
     return bdd_satcount(f) / std::pow(2, excess_variables);
   }
 
+  inline big_uint
+  satcount_exact(const bdd& f)
+  {
+    return this->satcount_exact(f, this->_varcount);
+  }
+
+  inline big_uint
+  satcount_exact(const bdd& f, const size_t vc)
+  {
+    struct view
+    {
+      using edge_type                        = BDD;
+      static constexpr bool complement_edges = false;
+
+      bool
+      is_terminal(const BDD e) const
+      {
+        // The terminals are always the first two nodes in BuDDy's node table.
+        return e == 0 || e == 1;
+      }
+
+      bool
+      terminal_value(const BDD e) const
+      {
+        return e == 1;
+      }
+
+      int
+      level(const BDD e) const
+      {
+        return bdd_var2level(bdd_var(e));
+      }
+
+      BDD
+      low(const BDD e) const
+      {
+        return bdd_low(e);
+      }
+
+      BDD
+      high(const BDD e) const
+      {
+        return bdd_high(e);
+      }
+
+      uint64_t
+      id(const BDD e) const
+      {
+        return e;
+      }
+    };
+
+    return bdd_satcount_exact(view(), f.id(), this->_varcount, vc);
+  }
+
   inline bdd
   satone(const bdd& f)
   {
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "common/adapter.h"
+#include "common/satcount.h"
 
 #include <calObj.hh>
 
@@ -23,6 +24,11 @@ public:
 
   static constexpr bool complement_edges = true;
 
+  static constexpr bool thread_safe      = false;
+  static constexpr bool supports_rename  = true;
+  static constexpr bool supports_relnext = true;
+  static constexpr bool exact_satcount   = false;
+
   // Variable type
 public:
   typedef BDD dd_t;
@@ -247,6 +253,24 @@ public:
     return _mgr.RelProd(std::move(shifted_states), rel);
   }
 
+  inline BDD
+  rename(const BDD& f, const std::function<int(int)>& m)
+  {
+    assert(is_variable_permutation(this->_varcount, m));
+
+    std::vector<std::pair<int, int>> pairs;
+    for (int x = 0; x < this->_varcount; ++x) {
+      if (m(x) != x) { pairs.push_back({ x, m(x) }); }
+    }
+
+    const int assoc = new_assoc_pairs(pairs.begin(), pairs.end());
+    _mgr.AssociationSetCurrent(assoc);
+
+    BDD res = _mgr.VarSubstitute(f);
+    _mgr.AssociationQuit(assoc);
+    return res;
+  }
+
   inline uint64_t
   nodecount(BDD f)
   {
@@ -267,6 +291,19 @@ public:
     return std::pow(2, numVars) * satFrac;
   }
 
+  inline big_uint
+  satcount_exact(BDD f)
+  {
+    return this->satcount_exact(f, _varcount);
+  }
+
+  inline big_uint
+  satcount_exact(BDD f, const size_t vc)
+  {
+    // CAL does not export its nodes; the count is only as precise as its fraction.
+    return big_uint::from_double(_mgr.SatisfyingFraction(f), static_cast<int>(vc));
+  }
+
   inline BDD
   satone(const BDD& f)
   {
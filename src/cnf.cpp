@@ -3,51 +3,131 @@
 #include <cassert>
 
 // Data structures
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <iostream>
 #include <limits>
 #include <optional>
+#include <queue>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 // Types
+#include <cstdint>
 #include <cstdlib>
 
 // For reading the CNF file
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
-#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "common/adapter.h"
+#include "common/bandwidth.h"
 #include "common/chrono.h"
+#include "common/force.h"
 #include "common/input.h"
 #include "common/json.h"
+#include "common/satcount.h"
 
 #ifdef BDD_BENCHMARK_STATS
-size_t largest_bdd = 0;
-size_t total_nodes = 0;
+// Atomic, since intermediate results may be computed in parallel (see `-d`)
+std::atomic<size_t> largest_bdd = 0;
+std::atomic<size_t> total_nodes = 0;
 #endif // BDD_BENCHMARK_STATS
 
 // ========================================================================== //
 std::string file;
-bool satcount = false;
+bool satcount   = false;
+bool preprocess = false;
+
+/// Recursion depth up to which the two halves of a balanced conjunction are computed in parallel
+int parallel_depth = 0;
+
+/// Supported variable orderings
+enum class variable_order : char
+{
+  /** The Cuthill-Mckee algorithm on the clause/variable incidence graph */
+  CUTHILL_MCKEE,
+  /** The FORCE heuristic of Aloul, Markov, and Sakallah (2003) */
+  FORCE,
+  /** Use the order in the file (if any) and otherwise the identity */
+  INPUT,
+  /** Recursive min-cut bisection as in MINCE by Aloul, Markov, and Sakallah (2001) */
+  MINCE
+};
+
+std::string
+to_string(const variable_order& vo)
+{
+  switch (vo) {
+  case variable_order::CUTHILL_MCKEE: return "cuthill-mckee";
+  case variable_order::FORCE: return "force";
+  case variable_order::INPUT: return "input";
+  case variable_order::MINCE: return "mince";
+  }
+  return "?";
+}
+
+variable_order var_order = variable_order::INPUT;
+
+/// Supported clause schedules, i.e. the order in which clauses are conjoined
+enum class clause_schedule : char
+{
+  /** (Approximately) balanced bracketing of the clauses in input order */
+  BALANCED,
+  /** Buckets of clauses with the same top variable, processed bottom-up */
+  BUCKET,
+  /** Repeatedly conjoin the two smallest BDDs */
+  PRIORITY,
+  /** Balanced bracketing of the clauses sorted by their span of levels */
+  SPAN
+};
+
+std::string
+to_string(const clause_schedule& cs)
+{
+  switch (cs) {
+  case clause_schedule::BALANCED: return "balanced";
+  case clause_schedule::BUCKET: return "bucket";
+  case clause_schedule::PRIORITY: return "priority";
+  case clause_schedule::SPAN: return "span";
+  }
+  return "?";
+}
+
+clause_schedule schedule = clause_schedule::BALANCED;
 
 class parsing_policy
 {
 public:
   static constexpr std::string_view name = "CNF";
-  static constexpr std::string_view args = "f:c";
+  static constexpr std::string_view args = "f:cd:o:ps:";
 
   static constexpr std::string_view help_text =
     "        -c                    Count satisfying assignments\n"
-    "        -f PATH               Path to '.cnf'/'.dimacs' file";
-
-  // NOTE: One could add more options to this benchmark, e.g., to influence the
-  // order in which the clauses are conjoined. The current implementation
-  // interprets the linear clause ordering given in the input file as an
-  // (approximately) balanced binary tree, e.g., `(c0 ∧ c1) ∧ (c2 ∧ (c3 ∧ c4))`.
-  // Importantly, it does not commute any operands, i.e., we do not conjoin `c0`
-  // and `c4` (or any dependant intermediate results) before `c1` has been
-  // processed.
+    "        -d DEPTH    [0]       Depth of parallel recursion in balanced conjunctions\n"
+    "        -f PATH               Path to '.cnf'/'.dimacs' file\n"
+    "        -o ORDER    [input]   Variable order (input/cuthill-mckee/force/mince)\n"
+    "        -p                    Preprocess the CNF before constructing the clauses\n"
+    "        -s SCHEDULE [balance] Clause schedule (balanced/bucket/priority/span)";
+
+  // NOTE: By default, this benchmark interprets the linear clause ordering
+  // given in the input file as an (approximately) balanced binary tree, e.g.,
+  // `(c0 ∧ c1) ∧ (c2 ∧ (c3 ∧ c4))`. Importantly, it does not commute any
+  // operands, i.e., we do not conjoin `c0` and `c4` (or any dependant
+  // intermediate results) before `c1` has been processed. Other schedules can
+  // be chosen with `-s`.
   //
   // In general, this benchmark allows quite important options to be tuned by
   // preprocessing the CNF. We can, e.g., apply preprocessing techniques from
@@ -61,6 +141,12 @@ public:
   // ensure that the algorithms are deterministic. Therefore it is much easier
   // (and also less time-consuming) to do all the preprocessing steps
   // externally.
+  //
+  // Yet, most CNF files do not come with a variable order. Hence, we provide a
+  // few simple (and deterministic) static variable ordering heuristics based
+  // on the clause hypergraph, see `-o`. Similarly, `-p` provides a few cheap
+  // (and count-preserving) simplifications in case the CNF has not been
+  // preprocessed.
 
   /// Parse one command line option, where `c` is one of keys specified in the
   /// `args` constant of this class and `arg` is the option's value (if the
@@ -88,6 +174,52 @@ public:
       satcount = true;
       return false;
     }
+    case 'd': {
+      parallel_depth = std::stoi(arg);
+      if (parallel_depth < 0) {
+        std::cerr << "  Must specify a non-negative depth (-d)\n";
+        return true;
+      }
+      return false;
+    }
+    case 'p': {
+      preprocess = true;
+      return false;
+    }
+    case 's': {
+      const std::string lower_arg = ascii_tolower(arg);
+
+      if (is_prefix(lower_arg, "balanced")) {
+        schedule = clause_schedule::BALANCED;
+      } else if (is_prefix(lower_arg, "bucket")) {
+        schedule = clause_schedule::BUCKET;
+      } else if (is_prefix(lower_arg, "priority") || is_prefix(lower_arg, "smallest-first")) {
+        schedule = clause_schedule::PRIORITY;
+      } else if (is_prefix(lower_arg, "span")) {
+        schedule = clause_schedule::SPAN;
+      } else {
+        std::cerr << "Undefined schedule: " << arg << "\n";
+        return true;
+      }
+      return false;
+    }
+    case 'o': {
+      const std::string lower_arg = ascii_tolower(arg);
+
+      if (is_prefix(lower_arg, "cuthill-mckee")) {
+        var_order = variable_order::CUTHILL_MCKEE;
+      } else if (is_prefix(lower_arg, "force")) {
+        var_order = variable_order::FORCE;
+      } else if (is_prefix(lower_arg, "input")) {
+        var_order = variable_order::INPUT;
+      } else if (is_prefix(lower_arg, "mince") || is_prefix(lower_arg, "min-cut")) {
+        var_order = variable_order::MINCE;
+      } else {
+        std::cerr << "Undefined ordering: " << arg << "\n";
+        return true;
+      }
+      return false;
+    }
     default: return true;
     }
   }
@@ -104,6 +236,215 @@ unsigned_abs(int value)
   return value < 0 ? 0 - unsigned(value) : unsigned(value);
 }
 
+/// Reader for DIMACS files
+///
+/// The file is memory-mapped and scanned by hand, which is much faster than
+/// `std::ifstream` and `operator>>` on files with millions of clauses. If the
+/// file cannot be mapped, e.g. because it is a pipe, then it is instead read in
+/// large blocks with `std::fread`. Compressed files are not supported.
+class dimacs_reader
+{
+  static constexpr size_t buffer_size = 1u << 20;
+
+  /// Memory-mapped content of the file (if it could be mapped)
+  void* _mapped       = nullptr;
+  size_t _mapped_size = 0;
+
+  /// Input file (if it could not be mapped)
+  FILE* _file = nullptr;
+
+  /// Whether a read error occurred
+  bool _bad = false;
+
+  std::unique_ptr<char[]> _buffer;
+  const char* _pos = nullptr;
+  const char* _end = nullptr;
+
+  /// Read the next block, returns `false` if there is nothing left to read
+  bool
+  refill()
+  {
+    if (_file == nullptr) { return false; }
+    const size_t n = std::fread(_buffer.get(), 1, buffer_size, _file);
+    if (n == 0) {
+      _bad |= std::ferror(_file) != 0;
+      return false;
+    }
+    _pos = _buffer.get();
+    _end = _pos + n;
+    return true;
+  }
+
+public:
+  explicit dimacs_reader(const std::string& path)
+  {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) { return; }
+
+    // Map regular files as a whole (the mapping stays valid after closing `fd`)
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && 0 < st.st_size) {
+      void* mapped = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapped != MAP_FAILED) {
+        ::madvise(mapped, st.st_size, MADV_SEQUENTIAL);
+
+        _mapped      = mapped;
+        _mapped_size = st.st_size;
+        _pos         = static_cast<const char*>(mapped);
+        _end         = _pos + _mapped_size;
+
+        ::close(fd);
+        return;
+      }
+    }
+
+    // Otherwise, fall back to reading it block by block
+    _file = ::fdopen(fd, "rb");
+    if (_file == nullptr) {
+      ::close(fd);
+      return;
+    }
+    _buffer.reset(new char[buffer_size]);
+  }
+
+  dimacs_reader(const dimacs_reader&) = delete;
+  dimacs_reader&
+  operator=(const dimacs_reader&) = delete;
+
+  ~dimacs_reader()
+  {
+    close();
+  }
+
+  /// Whether the file could be opened
+  bool
+  is_open() const
+  {
+    return _mapped != nullptr || _file != nullptr;
+  }
+
+  /// Close the file. Returns `false` if reading the file failed.
+  bool
+  close()
+  {
+    if (_mapped != nullptr) {
+      ::munmap(_mapped, _mapped_size);
+      _mapped = nullptr;
+      _pos = _end = nullptr;
+    }
+    if (_file != nullptr) {
+      _bad |= std::fclose(_file) != 0;
+      _file = nullptr;
+    }
+    return !_bad;
+  }
+
+  /// Get the next character without consuming it (`EOF` at the end of the file)
+  int
+  peek()
+  {
+    if (_pos == _end && !refill()) { return EOF; }
+    return static_cast<unsigned char>(*_pos);
+  }
+
+  /// Consume the next character (`EOF` at the end of the file)
+  int
+  get()
+  {
+    if (_pos == _end && !refill()) { return EOF; }
+    return static_cast<unsigned char>(*_pos++);
+  }
+
+  /// Skip spaces, tabs and line breaks
+  void
+  skip_whitespace()
+  {
+    for (int c = peek(); c == ' ' || c == '\n' || c == '\t' || c == '\r'; c = peek()) { ++_pos; }
+  }
+
+  /// Read the remainder of the current line into `out` (consuming the line break)
+  void
+  read_line(std::string& out)
+  {
+    out.clear();
+    while (_pos != _end || refill()) {
+      // Use `memchr` to search for the line break, which usually is vectorised.
+      const char* eol = static_cast<const char*>(std::memchr(_pos, '\n', _end - _pos));
+      if (eol != nullptr) {
+        out.append(_pos, eol);
+        _pos = eol + 1;
+        return;
+      }
+      out.append(_pos, _end);
+      _pos = _end;
+    }
+  }
+
+  /// Read a whitespace-separated token (skipping leading whitespace)
+  bool
+  read_token(std::string& out)
+  {
+    skip_whitespace();
+    out.clear();
+    for (int c = peek(); c != EOF && c != ' ' && c != '\n' && c != '\t' && c != '\r'; c = peek()) {
+      out += static_cast<char>(c);
+      ++_pos;
+    }
+    return !out.empty();
+  }
+
+  /// Read a (signed) decimal integer (skipping leading whitespace)
+  ///
+  /// Returns `false` if there is no integer at the current position or it is too large (more than
+  /// 18 digits). If there is no integer, no (non-whitespace) character is consumed unless it is a
+  /// sign.
+  bool
+  read_int(int64_t& out)
+  {
+    skip_whitespace();
+
+    // Fast path: the integer certainly ends within the buffer (an `int64_t` has at most 19 digits)
+    if (_end - _pos > 20) {
+      const char* pos     = _pos;
+      const bool negative = *pos == '-';
+      pos += negative;
+
+      if (*pos < '0' || '9' < *pos) {
+        _pos = pos;
+        return false;
+      }
+
+      uint64_t value = 0;
+      for (int digits = 0; '0' <= *pos && *pos <= '9'; ++pos, ++digits) {
+        if (digits == 18) { return false; }
+        value = value * 10 + static_cast<uint64_t>(*pos - '0');
+      }
+
+      _pos = pos;
+      out  = negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+      return true;
+    }
+
+    const bool negative = peek() == '-';
+    if (negative) { ++_pos; }
+
+    int c = peek();
+    if (c < '0' || '9' < c) { return false; }
+
+    uint64_t value = 0;
+    int digits     = 0;
+    do {
+      if (digits++ == 18) { return false; }
+      ++_pos;
+      value = value * 10 + static_cast<uint64_t>(c - '0');
+      c     = peek();
+    } while ('0' <= c && c <= '9');
+
+    out = negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+    return true;
+  }
+};
+
 class CNF
 {
   /// Literals of all clauses
@@ -118,6 +459,15 @@ class CNF
   /// Map from variables to levels
   std::vector<unsigned> _var_to_level;
 
+  /// Whether a variable is part of the projection set
+  ///
+  /// This vector is empty if no projection was declared, i.e., if all variables are to be counted.
+  std::vector<bool> _projected;
+
+  /// Whether a variable has been eliminated by `preprocess`, i.e., it has been fixed to a value or
+  /// it has been substituted by an equivalent literal.
+  std::vector<bool> _eliminated;
+
 public:
   /// Parse a DIMACS CNF file from `path`
   ///
@@ -139,49 +489,87 @@ public:
   /// order. Here, variable 2 called "b" is at the top, then variable 1 "a"
   /// follows, and so on. The variable order is optional but if present, if must
   /// contain all variables.
+  ///
+  /// Furthermore, the set of projection variables for projected model counting
+  /// may be declared with (one or more) lines of the form `c p show 1 3 0`
+  /// anywhere in the file.
   static std::optional<CNF>
   parse_dimacs_cnf(const std::string& path)
   {
-    size_t nclauses;
     CNF cnf;
-    std::ifstream input(path, std::ios::in);
+    dimacs_reader input(path);
+    if (!input.is_open()) {
+      std::cerr << "error: could not open '" << path << "'\n";
+      return {};
+    }
+
+    // Parse the variables of a `c p show <var>* 0` line from `in` (the `c p show` part has already
+    // been consumed). Returns `true` on error.
+    std::vector<unsigned> shown;
+    bool has_projection = false;
+    const auto parse_show = [&shown, &has_projection](std::istream& in) -> bool {
+      has_projection = true;
+      int var_id;
+      while (in >> var_id) {
+        if (var_id == 0) { return false; }
+        if (var_id < 0) {
+          std::cerr << "error: variable numbers must be > 0 (in projection)\n";
+          return true;
+        }
+        shown.push_back(var_id - 1);
+      }
+      std::cerr << "error: expected `c p show` line to be terminated by 0\n";
+      return true;
+    };
+
+    // Parse a comment line (the `c` has already been consumed). The variable order is only allowed
+    // before the problem line, i.e., if `var_order` is not `nullptr`. Returns `true` on error.
+    std::string comment_line, tok;
+    const auto parse_comment =
+      [&input, &comment_line, &tok, &parse_show](std::vector<unsigned>* var_order) -> bool {
+      input.read_line(comment_line);
+      std::istringstream comment(comment_line);
+      if (!(comment >> tok)) { return false; }
+
+      if (tok == "p") { return comment >> tok && tok == "show" && parse_show(comment); }
+
+      // Ignore lines where the token after `c` is not numeric. This allows extensions of the
+      // format.
+      if (var_order != nullptr && std::all_of(tok.begin(), tok.end(), ::isdigit)) {
+        const unsigned var_id = std::stoul(tok);
+        if (var_id == 0) {
+          std::cerr << "error: variable numbers must be > 0 (in variable order)\n";
+          return true;
+        }
+        var_order->push_back(var_id - 1);
+      }
+      return false;
+    };
 
     // Parse the variable order
     std::vector<unsigned> var_order;
-    std::string tok;
     unsigned line = 0;
-    while (input.good()) {
+    while (true) {
       const int c = input.get();
       ++line;
       if (c == 'c') {
-        input >> tok;
-        if (std::all_of(tok.begin(), tok.end(), ::isdigit)) {
-          // Ignore lines where the token after `c` is not numeric. This allows extensions of the
-          // format.
-
-          const unsigned var_id = std::stoul(tok);
-          if (var_id == 0) {
-            std::cerr << "error: variable numbers must be > 0 (in variable order)\n";
-            return {};
-          }
-          var_order.push_back(var_id - 1);
-        }
-        input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-      } else if (c == 'p') {
+        if (parse_comment(&var_order)) { return {}; }
+      } else if (c == 'p' || c == EOF) {
         break;
+      } else if (c == '\n' || c == '\r') {
+        continue; // skip empty lines
       } else {
         std::cerr << "error: unexpected character '" << static_cast<char>(c)
-                  << "' at beginning of line" << line << "\n";
+                  << "' at beginning of line " << line << "\n";
         return {};
       }
     }
 
     // Read the problem line (`p cnf <#vars> <#clauses>`)
     std::string problem_type;
-    unsigned nvars;
-    input >> problem_type >> nvars >> nclauses;
-
-    if (input.fail()) {
+    int64_t nvars_in, nclauses_in;
+    if (!input.read_token(problem_type) || !input.read_int(nvars_in)
+        || !input.read_int(nclauses_in) || nvars_in < 0 || nclauses_in < 0) {
       std::cerr << "error: expected `p cnf #vars #clauses` (line " << line << ")\n";
       return {};
     }
@@ -189,10 +577,13 @@ public:
       std::cerr << "error: can only handle 'cnf' files\n";
       return {};
     }
-    if (nvars >= unsigned(std::numeric_limits<int>::max())) {
+    if (nvars_in >= std::numeric_limits<int>::max()) {
       std::cerr << "error: too many variables\n";
       return {};
     }
+    const unsigned nvars   = nvars_in;
+    const size_t nclauses = nclauses_in;
+
     if (var_order.size() == 0) { // Allow no variable order to be given
       cnf._var_to_level.reserve(nvars);
       for (unsigned i = 0; i < nvars; i++) { cnf._var_to_level.push_back(i); }
@@ -205,9 +596,13 @@ public:
       constexpr unsigned NO_VAR = std::numeric_limits<unsigned>::max();
       cnf._var_to_level.resize(nvars, NO_VAR);
       for (unsigned i = 0; i < nvars; i++) {
+        if (var_order[i] >= nvars) {
+          std::cerr << "error: variable " << (var_order[i] + 1) << " in order but there are only "
+                    << nvars << " variables\n";
+          return {};
+        }
         if (cnf._var_to_level[var_order[i]] != NO_VAR) {
-          std::cerr << "error: variable " << cnf._var_to_level[var_order[i]]
-                    << "occurs twice in order\n";
+          std::cerr << "error: variable " << (var_order[i] + 1) << " occurs twice in order\n";
           return {};
         }
         cnf._var_to_level[var_order[i]] = i;
@@ -223,25 +618,31 @@ public:
     size_t clause_offset = 0;
     cnf._clause_data.reserve(nclauses * 4);
     cnf._clause_offsets.reserve(nclauses);
-    while (input.good()) {
-      int literal;
-      input >> literal;
-      if (input.fail()) {
-        if (input.eof())
-          break; // this branch is taken if there is whitespace at the end of the file
+    while (true) {
+      int64_t literal;
+      if (!input.read_int(literal)) {
+        const int c = input.peek();
+        if (c == EOF) break;
+
+        // Comment lines (e.g. projection declarations) may be interleaved with the clauses
+        if (c == 'c') {
+          input.get();
+          if (parse_comment(nullptr)) { return {}; }
+          continue;
+        }
+
         std::cerr << "error: expected an integer\n";
         return {};
       }
       if (literal == 0) {
         cnf._clause_offsets.push_back(clause_offset);
         clause_offset = cnf._clause_data.size();
-      } else if (unsigned_abs(literal) > nvars) {
+      } else if (literal > nvars_in || literal < -nvars_in) {
         std::cerr << "error: found literal " << literal << " but there are only " << nvars
-                  << "variables\n";
+                  << " variables\n";
         return {};
       } else {
-        assert(literal != 0);
-        cnf._clause_data.push_back(literal);
+        cnf._clause_data.push_back(static_cast<int>(literal));
       }
     }
     // The last 0 could be omitted in the input. It could also be that the last clause is empty; in
@@ -256,14 +657,360 @@ public:
       return {};
     }
 
-    if (input.bad()) {
+    if (!input.close()) {
       std::cerr << "error: reading from the input file failed\n";
       return {};
     }
 
+    cnf._eliminated.resize(nvars, false);
+
+    // Set up the projection (if any)
+    if (has_projection) {
+      cnf._projected.resize(nvars, false);
+      for (const unsigned var : shown) {
+        if (var >= nvars) {
+          std::cerr << "error: projection variable " << (var + 1) << " but there are only "
+                    << nvars << " variables\n";
+          return {};
+        }
+        cnf._projected[var] = true;
+      }
+    }
+
     return cnf;
   }
 
+  /// Statistics of `preprocess`
+  struct preprocess_stats
+  {
+    /// Number of variables fixed by unit propagation
+    size_t units = 0;
+    /// Number of variables substituted by an equivalent literal
+    size_t equivalences = 0;
+    /// Number of (non-projected) variables eliminated as pure literals
+    size_t pure_literals = 0;
+    /// Number of subsumed clauses removed
+    size_t subsumed = 0;
+  };
+
+  /// Simplify the clauses while preserving the (projected) model count
+  ///
+  /// Until a fixpoint is reached, this applies unit propagation,
+  /// equivalent-literal substitution (based on the strongly connected
+  /// components of the binary implication graph) and pure-literal elimination.
+  /// The latter does not preserve the model count and hence is only applied to
+  /// non-projected variables. Finally, subsumed clauses are removed.
+  ///
+  /// Fixed and substituted variables are excluded from `num_counted()`. If the
+  /// CNF turns out to be unsatisfiable, it is replaced by a single empty clause.
+  /// The relative order of the remaining clauses is preserved.
+  ///
+  /// Precondition: there is no empty clause
+  preprocess_stats
+  preprocess()
+  {
+    preprocess_stats stats;
+    const unsigned nvars = _var_to_level.size();
+    const size_t nclauses = num_clauses();
+
+    // Literals are encoded as `2 * var + negated`. The clauses are stored back-to-back in `lits`,
+    // where clause `c` starts at `start[c]` and has `length[c]` literals (which can only shrink).
+    std::vector<unsigned> lits;
+    lits.reserve(_clause_data.size());
+    for (const int l : _clause_data) { lits.push_back(2 * (unsigned_abs(l) - 1) + (l < 0)); }
+
+    std::vector<size_t> start(_clause_offsets.begin(), _clause_offsets.end());
+    std::vector<unsigned> length(nclauses);
+    for (size_t c = 0; c < nclauses; ++c) {
+      length[c] = (c + 1 < nclauses ? start[c + 1] : lits.size()) - start[c];
+    }
+
+    // Sort the literals of clause `c` and remove duplicates. Returns `false` if it is a tautology.
+    const auto normalize = [&lits, &start, &length](const size_t c) -> bool {
+      const auto begin = lits.begin() + start[c];
+      std::sort(begin, begin + length[c]);
+      length[c] = std::unique(begin, begin + length[c]) - begin;
+      for (unsigned i = 1; i < length[c]; ++i) {
+        if ((begin[i - 1] ^ 1u) == begin[i]) { return false; }
+      }
+      return true;
+    };
+
+    std::vector<bool> removed(nclauses);
+    for (size_t c = 0; c < nclauses; ++c) { removed[c] = !normalize(c); }
+
+    // Occurrence lists of all literals (of clauses that are not removed), where the clauses of
+    // literal `x` are `occurrences[occurrences_start[x]]` to `occurrences[occurrences_start[x+1]]`
+    // (exclusive). These may contain clauses that have been removed in the meantime.
+    std::vector<size_t> occurrences_start(2 * nvars + 1);
+    std::vector<size_t> occurrences;
+    const auto build_occurrences = [&]() {
+      std::fill(occurrences_start.begin(), occurrences_start.end(), 0u);
+      for (size_t c = 0; c < nclauses; ++c) {
+        if (removed[c]) { continue; }
+        for (size_t i = start[c]; i < start[c] + length[c]; ++i) {
+          occurrences_start[lits[i] + 1] += 1;
+        }
+      }
+      for (unsigned x = 0; x < 2 * nvars; ++x) { occurrences_start[x + 1] += occurrences_start[x]; }
+
+      occurrences.resize(occurrences_start.back());
+      std::vector<size_t> pos(occurrences_start.begin(), occurrences_start.end() - 1);
+      for (size_t c = 0; c < nclauses; ++c) {
+        if (removed[c]) { continue; }
+        for (size_t i = start[c]; i < start[c] + length[c]; ++i) {
+          occurrences[pos[lits[i]]++] = c;
+        }
+      }
+    };
+
+    std::vector<bool> assigned(nvars, false);
+    bool conflict = false;
+    bool changed  = true;
+
+    while (changed && !conflict) {
+      changed = false;
+      build_occurrences();
+
+      // --------------------------------------------------------------------
+      // Unit propagation
+      std::vector<unsigned> units;
+      for (size_t c = 0; c < nclauses; ++c) {
+        if (!removed[c] && length[c] == 1) { units.push_back(lits[start[c]]); }
+      }
+
+      std::vector<bool> is_true(2 * nvars, false);
+      for (size_t i = 0; i < units.size() && !conflict; ++i) {
+        const unsigned x = units[i];
+        if (is_true[x]) { continue; }
+        if (is_true[x ^ 1u]) {
+          conflict = true;
+          break;
+        }
+
+        is_true[x]         = true;
+        assigned[x / 2]    = true;
+        _eliminated[x / 2] = true;
+        stats.units += 1;
+        changed = true;
+
+        for (size_t o = occurrences_start[x]; o < occurrences_start[x + 1]; ++o) {
+          removed[occurrences[o]] = true;
+        }
+        for (size_t o = occurrences_start[x ^ 1u]; o < occurrences_start[(x ^ 1u) + 1]; ++o) {
+          const size_t c = occurrences[o];
+          if (removed[c]) { continue; }
+
+          const auto begin = lits.begin() + start[c];
+          length[c]        = std::remove(begin, begin + length[c], x ^ 1u) - begin;
+          if (length[c] == 0) {
+            conflict = true;
+            break;
+          }
+          if (length[c] == 1) { units.push_back(*begin); }
+        }
+      }
+      if (changed || conflict) { continue; }
+
+      // --------------------------------------------------------------------
+      // Equivalent literals, i.e., strongly connected components of the implication graph given
+      // by the binary clauses `a ∨ b`, i.e., `¬a → b` and `¬b → a`. These are found with an
+      // iterative version of Tarjan's algorithm.
+      std::vector<std::vector<unsigned>> implications(2 * nvars);
+      for (size_t c = 0; c < nclauses; ++c) {
+        if (removed[c] || length[c] != 2) { continue; }
+        const unsigned a = lits[start[c]], b = lits[start[c] + 1];
+        implications[a ^ 1u].push_back(b);
+        implications[b ^ 1u].push_back(a);
+      }
+
+      constexpr unsigned unvisited = std::numeric_limits<unsigned>::max();
+      std::vector<unsigned> index(2 * nvars, unvisited), lowlink(2 * nvars), component(2 * nvars);
+      std::vector<bool> on_stack(2 * nvars, false);
+      std::vector<unsigned> stack;
+      std::vector<std::pair<unsigned, size_t>> call_stack;
+      unsigned next_index = 0, next_component = 0;
+
+      for (unsigned root = 0; root < 2 * nvars; ++root) {
+        if (index[root] != unvisited) { continue; }
+
+        call_stack.push_back({ root, 0u });
+        index[root] = lowlink[root] = next_index++;
+        stack.push_back(root);
+        on_stack[root] = true;
+
+        while (!call_stack.empty()) {
+          auto& [x, i] = call_stack.back();
+          if (i < implications[x].size()) {
+            const unsigned y = implications[x][i++];
+            if (index[y] == unvisited) {
+              index[y] = lowlink[y] = next_index++;
+              stack.push_back(y);
+              on_stack[y] = true;
+              call_stack.push_back({ y, 0u });
+            } else if (on_stack[y]) {
+              lowlink[x] = std::min(lowlink[x], index[y]);
+            }
+            continue;
+          }
+
+          const unsigned done = x;
+          call_stack.pop_back();
+          if (!call_stack.empty()) {
+            const unsigned parent = call_stack.back().first;
+            lowlink[parent]       = std::min(lowlink[parent], lowlink[done]);
+          }
+          if (lowlink[done] == index[done]) {
+            unsigned y;
+            do {
+              y = stack.back();
+              stack.pop_back();
+              on_stack[y]  = false;
+              component[y] = next_component;
+            } while (y != done);
+            next_component += 1;
+          }
+        }
+      }
+
+      // Pick a representative for each component, preferring projected variables (and otherwise
+      // the smallest one). The complement of a component is a component itself, so its
+      // representative is the complement of the same literal.
+      std::vector<unsigned> representative(next_component, unvisited);
+      for (const bool projected : { true, false }) {
+        for (unsigned var = 0; var < nvars && !conflict; ++var) {
+          if (is_projected(var) != projected) { continue; }
+          if (component[2 * var] == component[2 * var + 1]) {
+            conflict = true; // x ≡ ¬x
+            break;
+          }
+          if (representative[component[2 * var]] == unvisited) {
+            representative[component[2 * var]]     = 2 * var;
+            representative[component[2 * var + 1]] = 2 * var + 1;
+          }
+        }
+      }
+      if (conflict) { continue; }
+
+      for (unsigned var = 0; var < nvars; ++var) {
+        if (representative[component[2 * var]] != 2 * var) {
+          _eliminated[var] = true;
+          stats.equivalences += 1;
+          changed = true;
+        }
+      }
+
+      if (changed) {
+        for (size_t c = 0; c < nclauses; ++c) {
+          if (removed[c]) { continue; }
+          for (size_t i = start[c]; i < start[c] + length[c]; ++i) {
+            lits[i] = representative[component[lits[i]]];
+          }
+          removed[c] = !normalize(c);
+        }
+        continue;
+      }
+
+      // --------------------------------------------------------------------
+      // Pure literals: for a non-projected variable `x` that only occurs positively (negatively),
+      // we have `∃x. (x ∨ A) ∧ B ≡ B`.
+      const auto occurs = [&](const unsigned x) {
+        for (size_t o = occurrences_start[x]; o < occurrences_start[x + 1]; ++o) {
+          if (!removed[occurrences[o]]) { return true; }
+        }
+        return false;
+      };
+
+      for (unsigned var = 0; has_projection() && var < nvars; ++var) {
+        if (is_projected(var) || assigned[var]) { continue; }
+
+        const bool pos = occurs(2 * var), neg = occurs(2 * var + 1);
+        if (pos == neg) { continue; }
+
+        const unsigned x = 2 * var + neg;
+        for (size_t o = occurrences_start[x]; o < occurrences_start[x + 1]; ++o) {
+          removed[occurrences[o]] = true;
+        }
+        stats.pure_literals += 1;
+        changed = true;
+      }
+    }
+
+    if (conflict) {
+      _clause_data.clear();
+      _clause_offsets.assign(1u, 0u);
+      return stats;
+    }
+
+    // ----------------------------------------------------------------------
+    // Subsumption: each clause removes all (later) supersets of it, which are
+    // found via the occurrence list of its rarest literal. Most candidates are
+    // ruled out by a (64 bit) signature of their literals, which is stored
+    // next to the occurrences for better locality.
+    build_occurrences();
+
+    std::vector<uint64_t> signatures(nclauses, 0u);
+    for (size_t c = 0; c < nclauses; ++c) {
+      for (size_t i = start[c]; i < start[c] + length[c]; ++i) {
+        signatures[c] |= uint64_t(1) << (lits[i] % 64);
+      }
+    }
+
+    std::vector<uint64_t> occurrence_signatures(occurrences.size());
+    for (size_t o = 0; o < occurrences.size(); ++o) {
+      occurrence_signatures[o] = signatures[occurrences[o]];
+    }
+
+    std::vector<size_t> by_length;
+    for (size_t c = 0; c < nclauses; ++c) {
+      if (!removed[c]) { by_length.push_back(c); }
+    }
+    std::stable_sort(by_length.begin(), by_length.end(), [&length](const size_t a, const size_t b) {
+      return length[a] < length[b];
+    });
+
+    for (const size_t c : by_length) {
+      if (removed[c]) { continue; }
+      const auto begin = lits.cbegin() + start[c], end = begin + length[c];
+
+      const auto occurrence_count = [&occurrences_start](const unsigned x) {
+        return occurrences_start[x + 1] - occurrences_start[x];
+      };
+      const unsigned rarest = *std::min_element(
+        begin, end, [&occurrence_count](const unsigned x, const unsigned y) {
+          return occurrence_count(x) < occurrence_count(y);
+        });
+
+      for (size_t o = occurrences_start[rarest]; o < occurrences_start[rarest + 1]; ++o) {
+        if ((signatures[c] & ~occurrence_signatures[o]) != 0) { continue; }
+
+        const size_t d = occurrences[o];
+        if (d == c || removed[d] || length[d] < length[c]) { continue; }
+
+        const auto d_begin = lits.cbegin() + start[d];
+        if (std::includes(d_begin, d_begin + length[d], begin, end)) {
+          removed[d] = true;
+          stats.subsumed += 1;
+        }
+      }
+    }
+
+    // ----------------------------------------------------------------------
+    // Write back the remaining clauses
+    _clause_data.clear();
+    _clause_offsets.clear();
+    for (size_t c = 0; c < nclauses; ++c) {
+      if (removed[c]) { continue; }
+      _clause_offsets.push_back(_clause_data.size());
+      for (size_t i = start[c]; i < start[c] + length[c]; ++i) {
+        const int var = static_cast<int>(lits[i] / 2) + 1;
+        _clause_data.push_back(lits[i] & 1 ? -var : var);
+      }
+    }
+
+    return stats;
+  }
+
   /// Returns `true` iff there is an empty clause
   bool
   has_empty_clause() const
@@ -273,7 +1020,7 @@ public:
       if (offset == last_offset) return true;
       last_offset = offset;
     }
-    return false;
+    return last_offset == _clause_data.size();
   }
 
   /// Get the number of clauses
@@ -290,6 +1037,50 @@ public:
     return _var_to_level;
   }
 
+  /// Whether a projection set was declared
+  bool
+  has_projection() const
+  {
+    return !_projected.empty();
+  }
+
+  /// Whether variable `var` is to be counted, i.e., it is not existentially quantified
+  bool
+  is_projected(unsigned var) const
+  {
+    return _projected.empty() || _projected[var];
+  }
+
+  /// Get the number of projection variables
+  size_t
+  num_projected() const
+  {
+    return has_projection() ? std::count(_projected.begin(), _projected.end(), true)
+                            : _var_to_level.size();
+  }
+
+  /// Get the number of variables that are to be counted, i.e., the projection variables that have
+  /// not been eliminated by `preprocess`
+  size_t
+  num_counted() const
+  {
+    size_t res = 0;
+    for (unsigned var = 0; var < _var_to_level.size(); ++var) {
+      res += is_projected(var) && !_eliminated[var];
+    }
+    return res;
+  }
+
+  /// Replace the variable to level mapping
+  ///
+  /// Precondition: `var_to_level` is a permutation of the same variables
+  void
+  set_var_to_level(std::vector<unsigned>&& var_to_level)
+  {
+    assert(var_to_level.size() == _var_to_level.size());
+    _var_to_level = std::move(var_to_level);
+  }
+
   /// Call `f(begin, end)` for each clause, where `begin` and `end` are random access iterators over
   /// the literals of the clause. Each literal `l` is an `int` unequal to 0, where `l` refers to
   /// variable `|l| - 1`.
@@ -307,28 +1098,378 @@ public:
 
 // ========================================================================== //
 
+/// The variables of each clause (without duplicates and in ascending order)
+std::vector<std::vector<unsigned>>
+clause_variables(const CNF& cnf)
+{
+  std::vector<std::vector<unsigned>> out;
+  out.reserve(cnf.num_clauses());
+
+  cnf.foreach_clause([&out](auto begin, auto end) {
+    std::vector<unsigned> vars;
+    vars.reserve(std::distance(begin, end));
+    for (; begin != end; ++begin) { vars.push_back(unsigned_abs(*begin) - 1); }
+
+    std::sort(vars.begin(), vars.end());
+    vars.erase(std::unique(vars.begin(), vars.end()), vars.end());
+
+    out.push_back(std::move(vars));
+  });
+
+  return out;
+}
+
+/// Convert a list of variables (from the top to the bottom) into a variable to
+/// level mapping
+std::vector<unsigned>
+to_var_to_level(const std::vector<unsigned>& order)
+{
+  std::vector<unsigned> out(order.size());
+  for (unsigned level = 0; level < order.size(); ++level) { out[order[level]] = level; }
+  return out;
+}
+
+/// Derive a variable order with the Cuthill-McKee algorithm
+///
+/// To not (quadratically) blow up on long clauses, this works on the incidence
+/// graph of clauses and variables, i.e. each clause is a vertex connected to
+/// its variables (similar to the "read/write graph" in "Bandwidth and Wavefront
+/// Reduction for Static Variable Ordering in Symbolic Model Checking" by Jeroen
+/// Meijer and Jaco van de Pol).
+std::vector<unsigned>
+cuthill_mckee_order(const CNF& cnf)
+{
+  const std::vector<std::vector<unsigned>> clauses = clause_variables(cnf);
+
+  const int clause_count = clauses.size();
+  const int var_count    = cnf.var_to_level().size();
+
+  std::vector<std::pair<int, int>> edges;
+  for (int c = 0; c < clause_count; ++c) {
+    for (const unsigned x : clauses[c]) { edges.push_back({ c, clause_count + x }); }
+  }
+
+  const std::vector<int> vertex_order =
+    bandwidth_ordering(clause_count + var_count, edges, bandwidth_order::CUTHILL_MCKEE);
+
+  std::vector<unsigned> order;
+  order.reserve(var_count);
+  for (const int v : vertex_order) {
+    if (v < clause_count) { continue; }
+    order.push_back(v - clause_count);
+  }
+  return to_var_to_level(order);
+}
+
+/// Derive a variable order with the FORCE heuristic (see `force`), where each
+/// clause is a hyperedge of its variables.
+std::vector<unsigned>
+force_order(const CNF& cnf)
+{
+  return force(clause_variables(cnf), cnf.var_to_level());
+}
+
+/// Recursive min-cut bisection of the clause hypergraph
+///
+/// Inspired by MINCE, see "MINCE: A Static Global Variable-Ordering Heuristic
+/// for SAT Search and BDD Manipulation" by Fadi A. Aloul, Igor L. Markov, and
+/// Karem A. Sakallah (2004). Instead of an external hypergraph partitioner,
+/// each bisection is refined with (deterministic) Fiduccia-Mattheyses passes.
+class mince_bisection
+{
+  /// Variables of each clause
+  const std::vector<std::vector<unsigned>> _clauses;
+
+  /// Clauses of each variable
+  std::vector<std::vector<size_t>> _var_clauses;
+
+  /// Identifier of the current bisection that a variable is part of
+  std::vector<size_t> _var_stamp;
+
+  /// Side of each variable in the current bisection
+  std::vector<char> _var_side;
+
+  /// Identifier of the current bisection that a clause's counters belong to
+  std::vector<size_t> _clause_stamp;
+
+  /// Number of variables on each side of a clause in the current bisection
+  std::vector<std::array<unsigned, 2>> _clause_count;
+
+  /// Identifier of the current bisection
+  size_t _stamp = 0u;
+
+  /// Gain of each (unlocked) variable in the current pass
+  std::vector<int> _var_gain;
+
+  /// Identifier of the pass in which a variable has been locked
+  std::vector<size_t> _var_locked;
+
+  /// Identifier of the current pass
+  size_t _pass = 0u;
+
+  /// Maximum number of Fiduccia-Mattheyses passes per bisection
+  static constexpr int max_passes = 8;
+
+  /// Maximum number of moves without an improvement before a pass is stopped
+  static constexpr size_t max_futile_moves = 256;
+
+public:
+  mince_bisection(const CNF& cnf)
+    : _clauses(clause_variables(cnf))
+    , _var_clauses(cnf.var_to_level().size())
+    , _var_stamp(cnf.var_to_level().size(), 0u)
+    , _var_side(cnf.var_to_level().size(), 0)
+    , _clause_stamp(_clauses.size(), 0u)
+    , _clause_count(_clauses.size(), { 0u, 0u })
+    , _var_gain(cnf.var_to_level().size(), 0)
+    , _var_locked(cnf.var_to_level().size(), 0u)
+  {
+    for (size_t c = 0; c < _clauses.size(); ++c) {
+      for (const unsigned x : _clauses[c]) { _var_clauses[x].push_back(c); }
+    }
+  }
+
+private:
+  /// Gain in cut clauses by moving `x` to the other side
+  int
+  gain(const unsigned x) const
+  {
+    const char side = _var_side[x];
+
+    int out = 0;
+    for (const size_t c : _var_clauses[x]) {
+      if (_clause_stamp[c] != _stamp) { continue; }
+
+      const std::array<unsigned, 2>& count = _clause_count[c];
+      if (count[0] + count[1] < 2) { continue; }
+
+      out += count[side] == 1;
+      out -= count[1 - side] == 0;
+    }
+    return out;
+  }
+
+  /// Move `x` to the other side
+  void
+  move(const unsigned x)
+  {
+    const char side = _var_side[x];
+    for (const size_t c : _var_clauses[x]) {
+      if (_clause_stamp[c] != _stamp) { continue; }
+      _clause_count[c][side] -= 1;
+      _clause_count[c][1 - side] += 1;
+    }
+    _var_side[x] = 1 - side;
+  }
+
+  /// One Fiduccia-Mattheyses pass on the variables in `[begin, end)`.
+  ///
+  /// Returns the improvement in the number of cut clauses.
+  int
+  fm_pass(const std::vector<unsigned>::iterator begin, const std::vector<unsigned>::iterator end)
+  {
+    const size_t size     = std::distance(begin, end);
+    const size_t min_side = std::max<size_t>(1u, size / 2 - std::max<size_t>(1u, size / 10));
+
+    std::array<size_t, 2> side_size = { 0u, 0u };
+    for (auto it = begin; it != end; ++it) { side_size[_var_side[*it]] += 1; }
+
+    // Max-priority queues of (gain, tie-breaker, variable) per side with lazy deletion.
+    using entry_t = std::tuple<int, unsigned, unsigned>;
+    std::array<std::priority_queue<entry_t>, 2> pq;
+
+    _pass += 1;
+    for (auto it = begin; it != end; ++it) {
+      _var_gain[*it] = gain(*it);
+      pq[_var_side[*it]].push({ _var_gain[*it], std::numeric_limits<unsigned>::max() - *it, *it });
+    }
+
+    std::vector<unsigned> moves;
+    int cumulative_gain = 0;
+    int best_gain       = 0;
+    size_t best_moves   = 0;
+
+    while (moves.size() < best_moves + max_futile_moves) {
+      // Clean up stale entries
+      for (char side = 0; side < 2; ++side) {
+        while (!pq[side].empty()) {
+          const auto [g, tb, x] = pq[side].top();
+          if (_var_locked[x] != _pass && _var_gain[x] == g && _var_side[x] == side) { break; }
+          pq[side].pop();
+        }
+      }
+
+      // Pick the best move that keeps the bisection balanced.
+      int side = -1;
+      for (char s = 0; s < 2; ++s) {
+        if (pq[s].empty() || side_size[s] <= min_side) { continue; }
+        if (side < 0 || std::get<0>(pq[side].top()) < std::get<0>(pq[s].top())) { side = s; }
+      }
+      if (side < 0) { break; }
+
+      const unsigned x = std::get<2>(pq[side].top());
+      pq[side].pop();
+
+      cumulative_gain += _var_gain[x];
+      move(x);
+      _var_locked[x] = _pass;
+      moves.push_back(x);
+
+      side_size[side] -= 1;
+      side_size[1 - side] += 1;
+
+      if (best_gain < cumulative_gain) {
+        best_gain  = cumulative_gain;
+        best_moves = moves.size();
+      }
+
+      // Update gain of neighbours
+      for (const size_t c : _var_clauses[x]) {
+        if (_clause_stamp[c] != _stamp) { continue; }
+        for (const unsigned y : _clauses[c]) {
+          if (_var_stamp[y] != _stamp || _var_locked[y] == _pass) { continue; }
+
+          const int g = gain(y);
+          if (g == _var_gain[y]) { continue; }
+
+          _var_gain[y] = g;
+          pq[_var_side[y]].push({ g, std::numeric_limits<unsigned>::max() - y, y });
+        }
+      }
+    }
+
+    // Roll back to the best prefix of moves
+    while (best_moves < moves.size()) {
+      move(moves.back());
+      moves.pop_back();
+    }
+
+    return best_gain;
+  }
+
+  /// Bisect (and reorder) the variables in `[begin, end)`.
+  void
+  bisect(const std::vector<unsigned>::iterator begin, const std::vector<unsigned>::iterator end)
+  {
+    const size_t size = std::distance(begin, end);
+    if (size <= 2) { return; }
+
+    // Initial bisection by the current order
+    _stamp += 1;
+    for (auto it = begin; it != end; ++it) {
+      _var_stamp[*it] = _stamp;
+      _var_side[*it]  = std::distance(begin, it) < static_cast<std::ptrdiff_t>(size / 2) ? 0 : 1;
+    }
+    for (auto it = begin; it != end; ++it) {
+      for (const size_t c : _var_clauses[*it]) {
+        if (_clause_stamp[c] != _stamp) {
+          _clause_stamp[c] = _stamp;
+          _clause_count[c] = { 0u, 0u };
+        }
+        _clause_count[c][_var_side[*it]] += 1;
+      }
+    }
+
+    // Improve bisection
+    for (int pass = 0; pass < max_passes && 0 < fm_pass(begin, end); ++pass)
+      ;
+
+    // Reorder and recurse
+    const auto mid = std::stable_partition(
+      begin, end, [this](const unsigned x) -> bool { return _var_side[x] == 0; });
+
+    bisect(begin, mid);
+    bisect(mid, end);
+  }
+
+public:
+  /// Derive the variable to level mapping starting from `var_to_level`
+  std::vector<unsigned>
+  operator()(const std::vector<unsigned>& var_to_level)
+  {
+    std::vector<unsigned> order(var_to_level.size());
+    for (unsigned x = 0; x < var_to_level.size(); ++x) { order[var_to_level[x]] = x; }
+
+    bisect(order.begin(), order.end());
+
+    return to_var_to_level(order);
+  }
+};
+
+/// Derive a variable order with recursive min-cut bisection
+std::vector<unsigned>
+mince_order(const CNF& cnf)
+{
+  return mince_bisection(cnf)(cnf.var_to_level());
+}
+
+/// Apply the chosen variable order to `cnf`
+void
+apply_variable_order(CNF& cnf, const variable_order& vo)
+{
+  switch (vo) {
+  case variable_order::CUTHILL_MCKEE: cnf.set_var_to_level(cuthill_mckee_order(cnf)); return;
+  case variable_order::FORCE: cnf.set_var_to_level(force_order(cnf)); return;
+  case variable_order::INPUT: return;
+  case variable_order::MINCE: cnf.set_var_to_level(mince_order(cnf)); return;
+  }
+}
+
+// ========================================================================== //
+
+/// The top-most and the bottom-most level of a clause
+using clause_span = std::pair<unsigned, unsigned>;
+
+/// An (intermediate) result of conjoining clauses
+///
+/// For projected model counting, we also keep track of the number of conjoined
+/// clauses that each (not yet quantified) non-projected level occurs in. As
+/// soon as this matches the number of all clauses the level occurs in (see
+/// `clause_occurrences`), the level can be existentially quantified.
+template <typename Adapter>
+struct conjunct
+{
+  typename Adapter::dd_t dd;
+
+  /// Pairs of non-projected levels and their number of occurrences (sorted by level)
+  std::vector<std::pair<unsigned, size_t>> occurrences;
+};
+
+/// For each level, the number of (constructed) clauses it occurs in if it is to
+/// be existentially quantified, and 0 otherwise.
+std::vector<size_t> clause_occurrences;
+
 /// Construct the clauses of `cnf`
 ///
 /// This will filter out clauses equivalent to `⊤`, so the resulting vector
-/// might be shorter than `cnf.num_clauses()`.
+/// might be shorter than `cnf.num_clauses()`. The span of each constructed
+/// clause is pushed to `spans`.
 ///
 /// Precondition: there is no empty clause
 template <typename Adapter>
-std::vector<typename Adapter::dd_t>
-construct_clauses(Adapter& adapter, const CNF& cnf)
+std::vector<conjunct<Adapter>>
+construct_clauses(Adapter& adapter, const CNF& cnf, std::vector<clause_span>& spans)
 {
-  std::vector<typename Adapter::dd_t> clauses;
+  std::vector<conjunct<Adapter>> clauses;
   clauses.reserve(cnf.num_clauses());
+  spans.reserve(cnf.num_clauses());
   const std::vector<unsigned>& var_to_level = cnf.var_to_level();
 
   // polarity of variables in the current clause
   std::vector<signed char> polarities(var_to_level.size());
 
+  // levels that are to be existentially quantified
+  std::vector<bool> quantified(var_to_level.size(), false);
+  for (unsigned var = 0; var < var_to_level.size(); ++var) {
+    quantified[var_to_level[var]] = !cnf.is_projected(var);
+  }
+
   // We directly construct the clauses using the builder (and do not use the
   // disjunction operator) for better performance on time-forward processing
   // implementations
 
-  cnf.foreach_clause([&adapter, &var_to_level, &polarities, &clauses](auto begin, auto end) {
+  cnf.foreach_clause([&adapter, &var_to_level, &polarities, &quantified, &clauses, &spans](
+                       auto begin, auto end) {
     // minimum and maximum variable defined in the clause
     unsigned min_level = var_to_level.size(), max_level = 0;
 
@@ -349,6 +1490,10 @@ construct_clauses(Adapter& adapter, const CNF& cnf)
     }
 
     assert(min_level <= max_level); // holds by the function's precondition
+    spans.push_back({ min_level, max_level });
+
+    // non-projected levels in the clause (in descending order)
+    std::vector<std::pair<unsigned, size_t>> occurrences;
 
     // ==============================
     // Construct the clause bottom-up
@@ -375,6 +1520,7 @@ construct_clauses(Adapter& adapter, const CNF& cnf)
     if (Adapter::needs_extend && level > min_level)
       tautology = adapter.build_node(level, tautology, tautology);
     polarities[level] = 0;
+    if (quantified[level]) { occurrences.push_back({ level, 1u }); }
 
     // nodes above `max_level`
     while (level-- != 0) {
@@ -386,17 +1532,106 @@ construct_clauses(Adapter& adapter, const CNF& cnf)
         polarities[level] = 0;
         clause_build      = pol == 1 ? adapter.build_node(level, /* lo */ clause_build, tautology)
                                      : adapter.build_node(level, /* lo */ tautology, clause_build);
+        if (quantified[level]) { occurrences.push_back({ level, 1u }); }
       }
       if (Adapter::needs_extend && level > min_level)
         tautology = adapter.build_node(level, tautology, tautology);
     }
 
-    clauses.push_back(adapter.build());
+    std::reverse(occurrences.begin(), occurrences.end());
+    clauses.push_back({ adapter.build(), std::move(occurrences) });
   });
 
   return clauses;
 }
 
+/// Existentially quantify the levels of `c` that do not occur in any other
+/// clause and initialise `clause_occurrences` for `conjoin_pair`.
+template <typename Adapter>
+void
+init_quantification(Adapter& adapter,
+                    std::vector<conjunct<Adapter>>& clauses,
+                    const size_t varcount)
+{
+  clause_occurrences.assign(varcount, 0u);
+  for (const conjunct<Adapter>& c : clauses) {
+    for (const auto& [level, count] : c.occurrences) { clause_occurrences[level] += count; }
+  }
+
+  std::vector<unsigned> quantify;
+  for (conjunct<Adapter>& c : clauses) {
+    quantify.clear();
+    auto it = std::remove_if(
+      c.occurrences.begin(), c.occurrences.end(), [&quantify](const auto& level_count) {
+        if (clause_occurrences[level_count.first] != level_count.second) { return false; }
+        quantify.push_back(level_count.first);
+        return true;
+      });
+    c.occurrences.erase(it, c.occurrences.end());
+
+    if constexpr (!Adapter::needs_extend) {
+      if (!quantify.empty()) { c.dd = adapter.exists(c.dd, quantify.crbegin(), quantify.crend()); }
+    } else {
+      assert(quantify.empty()); // projections are rejected for ZDDs, see `run_cnf`
+    }
+  }
+}
+
+/// Conjoin two (intermediate) results
+///
+/// All non-projected levels that do not occur in any other clause afterwards
+/// are existentially quantified.
+template <typename Adapter>
+conjunct<Adapter>
+conjoin_pair(Adapter& adapter, const conjunct<Adapter>& f, const conjunct<Adapter>& g)
+{
+  conjunct<Adapter> res{ f.dd & g.dd, {} };
+
+  // Merge the occurrences of `f` and `g`
+  std::vector<unsigned> quantify;
+  const auto add = [&res, &quantify](const unsigned level, const size_t count) {
+    if (count == clause_occurrences[level]) {
+      quantify.push_back(level);
+    } else {
+      res.occurrences.push_back({ level, count });
+    }
+  };
+
+  auto f_it = f.occurrences.cbegin(), g_it = g.occurrences.cbegin();
+  while (f_it != f.occurrences.cend() && g_it != g.occurrences.cend()) {
+    if (f_it->first < g_it->first) {
+      add(f_it->first, f_it->second);
+      ++f_it;
+    } else if (g_it->first < f_it->first) {
+      add(g_it->first, g_it->second);
+      ++g_it;
+    } else {
+      add(f_it->first, f_it->second + g_it->second);
+      ++f_it;
+      ++g_it;
+    }
+  }
+  for (; f_it != f.occurrences.cend(); ++f_it) { add(f_it->first, f_it->second); }
+  for (; g_it != g.occurrences.cend(); ++g_it) { add(g_it->first, g_it->second); }
+
+  if constexpr (!Adapter::needs_extend) {
+    if (!quantify.empty()) {
+      res.dd = adapter.exists(res.dd, quantify.crbegin(), quantify.crend());
+    }
+  } else {
+    assert(quantify.empty()); // projections are rejected for ZDDs, see `run_cnf`
+  }
+
+#ifdef BDD_BENCHMARK_STATS
+  const size_t nodecount = adapter.nodecount(res.dd);
+  size_t largest         = largest_bdd.load();
+  while (largest < nodecount && !largest_bdd.compare_exchange_weak(largest, nodecount)) {}
+  total_nodes += nodecount;
+#endif // BDD_BENCHMARK_STATS
+
+  return res;
+}
+
 /// Conjoin the clauses with an (approximately) balanced bracketing
 /// `(c0 ∧ c1) ∧ (c2 ∧ (c3 ∧ c4))`
 ///
@@ -407,24 +1642,150 @@ construct_clauses(Adapter& adapter, const CNF& cnf)
 /// Importantly, this function does not commute any operands, i.e., we do not
 /// conjoin `c0` and `c4` (or any dependant intermediate results) before `c1`
 /// has been processed.
+///
+/// If the BDD package is thread-safe, then the two halves are computed in
+/// parallel for the first `depth` levels of the recursion. The bracketing (and
+/// hence the result) is the same as for the sequential computation.
 template <typename Adapter, typename IT>
-typename Adapter::dd_t
-conjoin(Adapter& adapter, const IT begin, const IT end)
+conjunct<Adapter>
+conjoin(Adapter& adapter, const IT begin, const IT end, const int depth = parallel_depth)
 {
-  if (begin == end) return adapter.top();
+  if (begin == end) return { adapter.top(), {} };
   auto d = std::distance(begin, end);
   if (d == 1) return *begin;
 
-  const IT mid               = begin + d / 2;
-  typename Adapter::dd_t res = conjoin(adapter, begin, mid) & conjoin(adapter, mid, end);
+  const IT mid = begin + d / 2;
+
+  if constexpr (Adapter::thread_safe) {
+    if (depth > 0) {
+      std::optional<conjunct<Adapter>> lhs, rhs;
+      adapter.par(
+        [&]() {
+          lhs = conjoin(adapter, begin, mid, depth - 1);
+          return 0;
+        },
+        [&]() {
+          rhs = conjoin(adapter, mid, end, depth - 1);
+          return 0;
+        });
+      return conjoin_pair(adapter, *lhs, *rhs);
+    }
+  }
+  return conjoin_pair(adapter, conjoin(adapter, begin, mid, 0), conjoin(adapter, mid, end, 0));
+}
 
-#ifdef BDD_BENCHMARK_STATS
-  const size_t nodecount = adapter.nodecount(res);
-  largest_bdd            = std::max(largest_bdd, nodecount);
-  total_nodes += nodecount;
-#endif // BDD_BENCHMARK_STATS
+/// Conjoin the clauses bucket by bucket, where each bucket contains the clauses
+/// with the same top variable.
+///
+/// The buckets are processed from the bottom-most to the top-most variable;
+/// the clauses within each bucket are conjoined with a balanced bracketing
+/// whereafter they are conjoined with the result of the buckets below.
+template <typename Adapter>
+conjunct<Adapter>
+conjoin_buckets(Adapter& adapter,
+                std::vector<conjunct<Adapter>>& clauses,
+                const std::vector<clause_span>& spans,
+                const size_t varcount)
+{
+  std::vector<std::vector<size_t>> buckets(varcount);
+  for (size_t i = 0; i < clauses.size(); ++i) { buckets[spans[i].first].push_back(i); }
 
-  return res;
+  std::optional<conjunct<Adapter>> res;
+
+  for (size_t level = varcount; 0 < level--;) {
+    if (buckets[level].empty()) { continue; }
+
+    std::vector<conjunct<Adapter>> bucket;
+    bucket.reserve(buckets[level].size());
+    for (const size_t i : buckets[level]) { bucket.push_back(std::move(clauses[i])); }
+
+    conjunct<Adapter> bucket_res = conjoin(adapter, bucket.cbegin(), bucket.cend());
+    res = res ? conjoin_pair(adapter, bucket_res, *res) : std::move(bucket_res);
+  }
+
+  return res ? std::move(*res) : conjunct<Adapter>{ adapter.top(), {} };
+}
+
+/// Conjoin the clauses by repeatedly conjoining the two smallest BDDs
+///
+/// Ties are broken by the position of the (intermediate) results, i.e. the
+/// clauses in input order followed by the intermediate results in the order
+/// they were created.
+template <typename Adapter>
+conjunct<Adapter>
+conjoin_smallest_first(Adapter& adapter, std::vector<conjunct<Adapter>>& clauses)
+{
+  if (clauses.empty()) return { adapter.top(), {} };
+
+  // Minimum priority queue of (size, index)
+  using entry_t = std::pair<size_t, size_t>;
+  std::priority_queue<entry_t, std::vector<entry_t>, std::greater<>> pq;
+
+  for (size_t i = 0; i < clauses.size(); ++i) { pq.push({ adapter.nodecount(clauses[i].dd), i }); }
+
+  while (pq.size() > 1) {
+    const size_t i = pq.top().second;
+    pq.pop();
+    const size_t j = pq.top().second;
+    pq.pop();
+
+    conjunct<Adapter> res = conjoin_pair(adapter, clauses[i], clauses[j]);
+
+    // Free up memory
+    clauses[i] = { adapter.top(), {} };
+    clauses[j] = { adapter.top(), {} };
+
+    pq.push({ adapter.nodecount(res.dd), clauses.size() });
+    clauses.push_back(std::move(res));
+  }
+
+  return clauses[pq.top().second];
+}
+
+/// Conjoin the clauses with a balanced bracketing after having sorted them by
+/// their span, i.e. clauses on the bottom-most variables are clustered (and
+/// conjoined) first.
+template <typename Adapter>
+conjunct<Adapter>
+conjoin_spans(Adapter& adapter,
+              std::vector<conjunct<Adapter>>& clauses,
+              const std::vector<clause_span>& spans)
+{
+  std::vector<size_t> order(clauses.size());
+  for (size_t i = 0; i < order.size(); ++i) { order[i] = i; }
+
+  std::stable_sort(order.begin(), order.end(), [&spans](const size_t a, const size_t b) {
+    if (spans[a].second != spans[b].second) { return spans[a].second > spans[b].second; }
+    return spans[a].first > spans[b].first;
+  });
+
+  std::vector<conjunct<Adapter>> sorted_clauses;
+  sorted_clauses.reserve(clauses.size());
+  for (const size_t i : order) { sorted_clauses.push_back(std::move(clauses[i])); }
+
+  return conjoin(adapter, sorted_clauses.cbegin(), sorted_clauses.cend());
+}
+
+/// Conjoin the clauses with the chosen clause schedule
+///
+/// Non-projected variables are existentially quantified as soon as all clauses
+/// they occur in have been conjoined.
+template <typename Adapter>
+typename Adapter::dd_t
+conjoin(Adapter& adapter,
+        std::vector<conjunct<Adapter>>& clauses,
+        const std::vector<clause_span>& spans,
+        const size_t varcount)
+{
+  init_quantification(adapter, clauses, varcount);
+
+  switch (schedule) {
+  case clause_schedule::BALANCED: return conjoin(adapter, clauses.cbegin(), clauses.cend()).dd;
+  case clause_schedule::BUCKET: return conjoin_buckets(adapter, clauses, spans, varcount).dd;
+  case clause_schedule::PRIORITY: return conjoin_smallest_first(adapter, clauses).dd;
+  case clause_schedule::SPAN: return conjoin_spans(adapter, clauses, spans).dd;
+  }
+  return adapter.top();
 }
 
 // ========================================================================== //
@@ -450,44 +1811,110 @@ run_cnf(int argc, char** argv)
     return -1;
   }
 
+  // Existential quantification of a ZDD does not remove the quantified variables from its
+  // (explicit) domain, and not all ZDD packages support it. Hence, projected model counting is
+  // only available for BDDs.
+  if constexpr (Adapter::needs_extend) {
+    if (cnf->has_projection()) {
+      std::cerr << "Projected model counting is not supported for " << Adapter::dd << "s\n";
+      return -1;
+    }
+  }
+
+  // Simplify the clauses
+  CNF::preprocess_stats preprocess_stats;
+
+  const time_point t_preprocess_before = now();
+  if (preprocess) { preprocess_stats = cnf->preprocess(); }
+  const time_point t_preprocess_after = now();
+
+  const time_duration preprocess_time = duration_ms(t_preprocess_before, t_preprocess_after);
+
+  if (cnf->has_empty_clause()) {
+    std::cerr << "Preprocessing derived the empty clause, i.e., the CNF is unsatisfiable\n";
+    return -1;
+  }
+
+  // Derive variable order
+  const time_point t_order_before = now();
+  apply_variable_order(*cnf, var_order);
+  const time_point t_order_after = now();
+
+  const time_duration order_time = duration_ms(t_order_before, t_order_after);
+
   // =========================================================================
   // Initialise BDD manager
-  return run<Adapter>("cnf", cnf->var_to_level().size(), [&cnf](Adapter& adapter) {
-    uint64_t solutions;
+  return run<Adapter>("cnf", cnf->var_to_level().size(), [&](Adapter& adapter) {
+    big_uint solutions;
+
+    if (preprocess) {
+      std::cout << json::field("preprocessing") << json::brace_open << json::endl;
+      std::cout << json::field("units") << json::value(preprocess_stats.units) << json::comma
+                << json::endl;
+      std::cout << json::field("equivalences") << json::value(preprocess_stats.equivalences)
+                << json::comma << json::endl;
+      std::cout << json::field("pure literals") << json::value(preprocess_stats.pure_literals)
+                << json::comma << json::endl;
+      std::cout << json::field("subsumed clauses") << json::value(preprocess_stats.subsumed)
+                << json::comma << json::endl;
+      std::cout << json::field("time (ms)") << json::value(preprocess_time) << json::endl;
+      std::cout << json::brace_close << json::comma << json::endl;
+      std::cout << json::endl;
+    }
+
+    std::cout << json::field("variable order") << json::brace_open << json::endl;
+    std::cout << json::field("name") << json::value(to_string(var_order)) << json::comma
+              << json::endl;
+    std::cout << json::field("time (ms)") << json::value(order_time) << json::endl;
+    std::cout << json::brace_close << json::comma << json::endl;
+    std::cout << json::endl;
 
     // ========================================================================
     // Construct a BDD for each clause
 
     std::cout << json::field("clauses") << json::brace_open << json::endl << json::flush;
 
-    const time_point t1                         = now();
-    std::vector<typename Adapter::dd_t> clauses = construct_clauses(adapter, *cnf);
-    const time_point t2                         = now();
+    std::vector<clause_span> spans;
+
+    const time_point t1                    = now();
+    std::vector<conjunct<Adapter>> clauses = construct_clauses(adapter, *cnf, spans);
+    const time_point t2                    = now();
 
     const time_duration clause_cons_time = duration_ms(t1, t2);
     std::cout << json::field("amount") << json::value(clauses.size()) << json::comma << json::endl;
+    if (cnf->has_projection()) {
+      std::cout << json::field("projected variables") << json::value(cnf->num_projected())
+                << json::comma << json::endl;
+    }
     std::cout << json::field("time (ms)") << json::value(clause_cons_time) << json::endl;
 
     std::cout << json::brace_close << json::comma << json::endl;
 
     // ========================================================================
     // Compute conjunction
-    std::cout << json::field("apply") << json::brace_open << json::endl << json::flush;
+    std::cout << json::field("apply") << json::brace_open << json::endl;
+    std::cout << json::field("schedule") << json::value(to_string(schedule)) << json::comma
+              << json::endl;
+    std::cout << json::field("parallel depth")
+              << json::value(Adapter::thread_safe ? parallel_depth : 0) << json::comma
+              << json::endl
+              << json::flush;
 
 #ifdef BDD_BENCHMARK_STATS
     std::cout << json::field("intermediate results") << json::brace_open << json::endl;
 #endif // BDD_BENCHMARK_STATS
 
     const time_point t3        = now();
-    typename Adapter::dd_t res = conjoin(adapter, clauses.cbegin(), clauses.cend());
+    typename Adapter::dd_t res = conjoin(adapter, clauses, spans, cnf->var_to_level().size());
     const time_point t4        = now();
 
     const time_duration apply_time = duration_ms(t3, t4);
 
 #ifdef BDD_BENCHMARK_STATS
-    std::cout << json::field("total processed (nodes)") << json::value(total_nodes) << json::comma
+    std::cout << json::field("total processed (nodes)") << json::value(total_nodes.load())
+              << json::comma << json::endl;
+    std::cout << json::field("largest size (nodes)") << json::value(largest_bdd.load())
               << json::endl;
-    std::cout << json::field("largest size (nodes)") << json::value(largest_bdd) << json::endl;
     std::cout << json::brace_close << json::comma << json::endl;
 #endif // BDD_BENCHMARK_STATS
     std::cout << json::field("final size (nodes)") << json::value(adapter.nodecount(res))
@@ -501,15 +1928,33 @@ run_cnf(int argc, char** argv)
     if (satcount) {
       std::cout << json::field("satcount") << json::brace_open << json::endl << json::flush;
 
+      // All non-projected variables have been quantified and all variables eliminated during
+      // preprocessing are gone, i.e., the result does not depend on them.
       const time_point t5 = now();
-      solutions           = adapter.satcount(res);
+      if constexpr (Adapter::needs_extend) {
+        // The domain of a ZDD is explicit and includes the eliminated variables as don't cares,
+        // i.e., each solution is counted once for every assignment to them.
+        solutions = adapter.satcount_exact(res);
+        solutions >>= cnf->var_to_level().size() - cnf->num_counted();
+      } else {
+        solutions = adapter.satcount_exact(res, cnf->num_counted());
+      }
       const time_point t6 = now();
 
       counting_time = duration_ms(t5, t6);
 
       std::cout << json::field("result") << json::value(solutions) << json::comma << json::endl;
+      std::cout << json::field("approximate") << json::value(!Adapter::exact_satcount)
+                << json::comma << json::endl;
+      std::cout << json::field("result (log2)");
+      if (solutions.is_zero()) {
+        std::cout << json::nil;
+      } else {
+        std::cout << json::value(solutions.log2());
+      }
+      std::cout << json::comma << json::endl;
       std::cout << json::field("time (ms)") << json::value(counting_time) << json::endl;
-      std::cout << json::brace_close << json::endl << json::flush;
+      std::cout << json::brace_close << json::comma << json::endl << json::flush;
     }
 
     // ========================================================================
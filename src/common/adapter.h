@@ -4,8 +4,10 @@
 #include <cstdint>
 #include <iostream>
 #include <cassert>
+#include <numeric>
 #include <string>
 #include <sys/resource.h>
+#include <vector>
 
 #include "./chrono.h"
 #include "./input.h"
@@ -39,6 +41,57 @@ ilog2(unsigned long long n)
 #endif
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Permutation of all `varcount` variables that renames each variable
+///        `x` in the `domain` to `m(x)`.
+///
+/// \details Outside of the `domain`, `m` may be arbitrary, e.g. map multiple
+///          variables to the same one. Hence, each variable displaced by `x` is
+///          instead swapped to the previous target of `x`.
+///
+/// \pre `m` is injective on the `domain`.
+////////////////////////////////////////////////////////////////////////////////
+template <typename Domain, typename Map>
+std::vector<int>
+rename_permutation(const int varcount, const Domain& domain, const Map& m)
+{
+  std::vector<int> permute(varcount);
+  std::iota(permute.begin(), permute.end(), 0);
+
+  std::vector<int> inverse = permute;
+
+  for (const int x : domain) {
+    const int y = m(x);
+    const int z = inverse[y];
+
+    const int x_target = permute[x];
+    permute[z]         = x_target;
+    inverse[x_target]  = z;
+    permute[x]         = y;
+    inverse[y]         = x;
+  }
+#ifndef NDEBUG
+  for (const int x : domain) { assert(permute[x] == m(x)); }
+#endif // NDEBUG
+  return permute;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Whether `m` is a permutation of all `varcount` variables.
+////////////////////////////////////////////////////////////////////////////////
+template <typename Map>
+bool
+is_variable_permutation(const int varcount, const Map& m)
+{
+  std::vector<bool> hit(varcount, false);
+  for (int x = 0; x < varcount; ++x) {
+    const int y = m(x);
+    if (y < 0 || varcount <= y || hit[y]) { return false; }
+    hit[y] = true;
+  }
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Print resource usage as JSON object
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,111 @@
+#ifndef BDD_BENCHMARK_COMMON_BANDWIDTH_H
+#define BDD_BENCHMARK_COMMON_BANDWIDTH_H
+
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Boost (requires the benchmark to be linked with `Boost::boost`)
+#include <boost/config.hpp>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/cuthill_mckee_ordering.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/graph/sloan_ordering.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Algorithms to order the vertices of an undirected graph such that its bandwidth, i.e. the
+///        largest distance between two adjacent vertices, is small.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+enum class bandwidth_order
+{
+  /** Cuthill-McKee algorithm */
+  CUTHILL_MCKEE,
+  /** Sloan's algorithm, starting and ending each component in an arbitrary vertex */
+  SLOAN,
+  /** Sloan's algorithm, starting and ending each component in a pseudo-peripheral pair */
+  SLOAN__PSEUDO_PERIPHERAL
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Order the vertices `0, 1, ..., vertices-1` of the undirected graph with the given edges.
+///
+/// \details All components of the graph are included in the resulting order.
+///
+/// \returns The vertices in the derived order.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline std::vector<int>
+bandwidth_ordering(const int vertices,
+                   const std::vector<std::pair<int, int>>& edges,
+                   const bandwidth_order algorithm)
+{
+  using boost__vertex_properties = boost::property<
+    boost::vertex_color_t,
+    boost::default_color_type,
+    boost::property<boost::vertex_degree_t, int, boost::property<boost::vertex_priority_t, int>>>;
+
+  using boost__graph_type =
+    boost::adjacency_list<boost::setS, boost::vecS, boost::undirectedS, boost__vertex_properties>;
+
+  using boost__vertex_type = boost::graph_traits<boost__graph_type>::vertex_descriptor;
+
+  boost__graph_type g(vertices);
+  for (const auto& [u, v] : edges) {
+    if (u != v) { boost::add_edge(u, v, g); }
+  }
+
+  const auto g_color  = boost::get(boost::vertex_color, g);
+  const auto g_degree = boost::make_degree_map(g);
+
+  std::vector<boost__vertex_type> boost_order(vertices);
+
+  switch (algorithm) {
+  case bandwidth_order::CUTHILL_MCKEE: {
+    // From Boost Documentation on "Sloan's Ordering":
+    //   "Usually you need the reversed ordering with the Cuthill-McKee algorithm (...)"
+    //
+    // From our preliminary experiments, the opposite is the case for BDDs.
+    boost::cuthill_mckee_ordering(g, boost_order.begin(), g_color, g_degree);
+    break;
+  }
+  case bandwidth_order::SLOAN:
+  case bandwidth_order::SLOAN__PSEUDO_PERIPHERAL: {
+    const auto g_priority = boost::get(boost::vertex_priority, g);
+
+    // From Boost Documentation on "Sloan's Ordering":
+    //   "(...) and the direct ordering with the Sloan algorithm."
+    //
+    // From our preliminary experiments, the opposite is the case for BDDs.
+    //
+    // Cuthill-McKee ensures all components are numbered. Yet, Sloan's algorithm only provides a
+    // relabelling of the component of the start vertex. Hence, it is applied to each component
+    // separately.
+    std::unordered_set<boost__vertex_type> boost_uncovered;
+    for (boost__vertex_type x = 0; x < boost::num_vertices(g); ++x) { boost_uncovered.insert(x); }
+
+    auto rbegin = boost_order.rbegin();
+    while (!boost_uncovered.empty()) {
+      boost__vertex_type s = *boost_uncovered.begin();
+      boost__vertex_type e = s;
+
+      if (algorithm == bandwidth_order::SLOAN__PSEUDO_PERIPHERAL) {
+        int eccentricity;
+        s = boost::find_starting_node(g, s, g_color, g_degree);
+        e = boost::pseudo_peripheral_pair(g, s, eccentricity, g_color, g_degree);
+      }
+
+      const auto next_rbegin =
+        boost::sloan_ordering(g, s, e, rbegin, g_color, g_degree, g_priority);
+
+      for (auto x_iter = rbegin; x_iter != next_rbegin; ++x_iter) {
+        boost_uncovered.erase(*x_iter);
+      }
+      rbegin = next_rbegin;
+    }
+    break;
+  }
+  }
+
+  return std::vector<int>(boost_order.begin(), boost_order.end());
+}
+
+#endif // BDD_BENCHMARK_COMMON_BANDWIDTH_H
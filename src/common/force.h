@@ -0,0 +1,106 @@
+#ifndef BDD_BENCHMARK_COMMON_FORCE_H
+#define BDD_BENCHMARK_COMMON_FORCE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "./adapter.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Total span of all hyperedges, i.e. the sum of the distances between the first and the
+///        last position of each hyperedge.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline size_t
+force_span(const std::vector<std::vector<unsigned>>& hyperedges,
+           const std::vector<unsigned>& position)
+{
+  size_t res = 0u;
+  for (const std::vector<unsigned>& e : hyperedges) {
+    if (e.empty()) { continue; }
+
+    unsigned min = position[e.front()], max = min;
+    for (const unsigned v : e) {
+      min = std::min(min, position[v]);
+      max = std::max(max, position[v]);
+    }
+    res += max - min;
+  }
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The FORCE heuristic from "FORCE: A Fast and Easy-To-Implement Variable-Ordering
+///        Heuristic" by Fadi A. Aloul, Igor L. Markov, and Karem A. Sakallah (2003).
+///
+/// \details Starting from the given placement of the vertices on a line, each vertex is moved to
+///          the average center of gravity of the hyperedges it is part of; vertices without any
+///          hyperedge stay where they are. Afterwards, the vertices are spread out again by their
+///          rank, where ties are resolved by their prior position to keep everything deterministic.
+///          This is repeated as long as the total span of all hyperedges decreases (up to some
+///          bound).
+///
+/// \param hyperedges The vertices of each hyperedge (without duplicates).
+///
+/// \param position   The initial position of each vertex, i.e. a permutation of `0, 1, ..., n-1`.
+///
+/// \returns The position of each vertex in the best placement found.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline std::vector<unsigned>
+force(const std::vector<std::vector<unsigned>>& hyperedges, std::vector<unsigned> position)
+{
+  const size_t vertex_count = position.size();
+
+  std::vector<unsigned> best = position;
+  size_t best_span           = force_span(hyperedges, best);
+
+  // Bound the number of iterations logarithmically (as suggested by Aloul et al.)
+  const size_t max_iterations = 10 * ilog2(std::max<size_t>(vertex_count, 2u));
+
+  std::vector<double> cog_sum(vertex_count);
+  std::vector<size_t> cog_count(vertex_count);
+
+  std::vector<std::pair<double, unsigned>> tentative(vertex_count);
+  std::vector<unsigned> rank(vertex_count);
+
+  for (size_t i = 0; i < max_iterations; ++i) {
+    std::fill(cog_sum.begin(), cog_sum.end(), 0.0);
+    std::fill(cog_count.begin(), cog_count.end(), 0u);
+
+    for (const std::vector<unsigned>& e : hyperedges) {
+      if (e.empty()) { continue; }
+
+      double cog = 0.0;
+      for (const unsigned v : e) { cog += position[v]; }
+      cog /= e.size();
+
+      for (const unsigned v : e) {
+        cog_sum[v] += cog;
+        cog_count[v] += 1;
+      }
+    }
+
+    for (unsigned v = 0; v < vertex_count; ++v) {
+      const double pos = cog_count[v] == 0 ? position[v] : cog_sum[v] / cog_count[v];
+      tentative[v]     = { pos, position[v] };
+    }
+
+    std::iota(rank.begin(), rank.end(), 0u);
+    std::sort(rank.begin(), rank.end(), [&tentative](const unsigned a, const unsigned b) {
+      return tentative[a] < tentative[b];
+    });
+    for (unsigned r = 0; r < vertex_count; ++r) { position[rank[r]] = r; }
+
+    const size_t span = force_span(hyperedges, position);
+    if (best_span <= span) { break; }
+
+    best      = position;
+    best_span = span;
+  }
+
+  return best;
+}
+
+#endif // BDD_BENCHMARK_COMMON_FORCE_H
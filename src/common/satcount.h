@@ -0,0 +1,417 @@
+#ifndef BDD_BENCHMARK_COMMON_SATCOUNT_H
+#define BDD_BENCHMARK_COMMON_SATCOUNT_H
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Unsigned integer of arbitrary precision.
+///
+/// \details Only the operations needed to count (and print) the number of satisfying assignments
+///          of a decision diagram are provided. The value is stored as little-endian 32-bit limbs
+///          without any leading zero limbs.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class big_uint
+{
+private:
+  std::vector<uint32_t> _limbs;
+
+public:
+  big_uint() = default;
+
+  big_uint(const uint64_t x)
+  {
+    if (x != 0u) { _limbs.push_back(static_cast<uint32_t>(x)); }
+    if ((x >> 32) != 0u) { _limbs.push_back(static_cast<uint32_t>(x >> 32)); }
+  }
+
+  /// \brief The value `2^e`.
+  static big_uint
+  pow2(const size_t e)
+  {
+    big_uint res(1u);
+    res <<= e;
+    return res;
+  }
+
+  /// \brief The integral part of `d * 2^e`.
+  ///
+  /// \details This is exact for the given `double`, but of course not any more precise than it.
+  static big_uint
+  from_double(const double d, const int e = 0)
+  {
+    assert(std::isfinite(d) && 0.0 <= d);
+
+    int d_exp;
+    const double mantissa = std::frexp(d, &d_exp);
+
+    // Move the 53 bits of the mantissa into an integer and shift it into place.
+    constexpr int mantissa_bits = std::numeric_limits<double>::digits;
+
+    big_uint res(static_cast<uint64_t>(std::ldexp(mantissa, mantissa_bits)));
+
+    const int shift = d_exp + e - mantissa_bits;
+    if (0 < shift) {
+      res <<= shift;
+    } else {
+      res >>= -shift;
+    }
+    return res;
+  }
+
+public:
+  bool
+  is_zero() const
+  {
+    return _limbs.empty();
+  }
+
+  /// \brief Whether the value fits into a `uint64_t`.
+  bool
+  fits_uint64() const
+  {
+    return _limbs.size() <= 2u;
+  }
+
+  /// \brief Value as a `uint64_t`, assuming it `fits_uint64()`.
+  uint64_t
+  to_uint64() const
+  {
+    assert(fits_uint64());
+
+    uint64_t res = 0u;
+    for (size_t i = _limbs.size(); 0 < i; --i) { res = (res << 32) | _limbs[i - 1]; }
+    return res;
+  }
+
+  /// \brief Number of bits needed to represent the value.
+  size_t
+  bit_width() const
+  {
+    if (is_zero()) { return 0u; }
+
+    size_t res = 32u * (_limbs.size() - 1u);
+    for (uint32_t top = _limbs.back(); top != 0u; top >>= 1) { ++res; }
+    return res;
+  }
+
+  /// \brief Base 2 logarithm of the value (`-infinity` for zero).
+  double
+  log2() const
+  {
+    if (is_zero()) { return -std::numeric_limits<double>::infinity(); }
+
+    // Only the 64 most significant bits matter for the precision of a `double`.
+    const size_t width = bit_width();
+    const size_t shift = width <= 64u ? 0u : width - 64u;
+
+    big_uint top = *this;
+    top >>= shift;
+
+    return std::log2(static_cast<double>(top.to_uint64())) + static_cast<double>(shift);
+  }
+
+  /// \brief Decimal representation.
+  std::string
+  to_string() const
+  {
+    if (is_zero()) { return "0"; }
+
+    // Repeatedly divide by 10^9 and collect the remainders.
+    constexpr uint32_t chunk = 1000000000u;
+
+    std::vector<uint32_t> limbs = _limbs;
+    std::vector<uint32_t> chunks;
+
+    while (!limbs.empty()) {
+      uint64_t rem = 0u;
+      for (size_t i = limbs.size(); 0 < i; --i) {
+        const uint64_t x = (rem << 32) | limbs[i - 1];
+        limbs[i - 1]     = static_cast<uint32_t>(x / chunk);
+        rem              = x % chunk;
+      }
+      while (!limbs.empty() && limbs.back() == 0u) { limbs.pop_back(); }
+      chunks.push_back(static_cast<uint32_t>(rem));
+    }
+
+    std::string res = std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1u; 0 < i; --i) {
+      const std::string digits = std::to_string(chunks[i - 1]);
+      res.append(9u - digits.size(), '0');
+      res.append(digits);
+    }
+    return res;
+  }
+
+public:
+  big_uint&
+  operator+=(const big_uint& o)
+  {
+    if (_limbs.size() < o._limbs.size()) { _limbs.resize(o._limbs.size(), 0u); }
+
+    uint64_t carry = 0u;
+    for (size_t i = 0u; i < _limbs.size(); ++i) {
+      if (o._limbs.size() <= i && carry == 0u) { break; }
+
+      const uint64_t x = carry + _limbs[i] + (i < o._limbs.size() ? o._limbs[i] : 0u);
+      _limbs[i]        = static_cast<uint32_t>(x);
+      carry            = x >> 32;
+    }
+    if (carry != 0u) { _limbs.push_back(static_cast<uint32_t>(carry)); }
+    return *this;
+  }
+
+  /// \pre `o <= *this`
+  big_uint&
+  operator-=(const big_uint& o)
+  {
+    assert(o._limbs.size() <= _limbs.size());
+
+    int64_t borrow = 0;
+    for (size_t i = 0u; i < _limbs.size(); ++i) {
+      if (o._limbs.size() <= i && borrow == 0) { break; }
+
+      int64_t x = static_cast<int64_t>(_limbs[i]) - borrow
+        - (i < o._limbs.size() ? static_cast<int64_t>(o._limbs[i]) : 0);
+
+      borrow = x < 0 ? 1 : 0;
+      if (x < 0) { x += static_cast<int64_t>(1) << 32; }
+      _limbs[i] = static_cast<uint32_t>(x);
+    }
+    assert(borrow == 0);
+
+    trim();
+    return *this;
+  }
+
+  big_uint&
+  operator<<=(const size_t n)
+  {
+    if (is_zero() || n == 0u) { return *this; }
+
+    const size_t limb_shift = n / 32u;
+    const size_t bit_shift  = n % 32u;
+
+    if (bit_shift != 0u) {
+      uint32_t carry = 0u;
+      for (uint32_t& l : _limbs) {
+        const uint32_t next_carry = l >> (32u - bit_shift);
+        l                         = (l << bit_shift) | carry;
+        carry                     = next_carry;
+      }
+      if (carry != 0u) { _limbs.push_back(carry); }
+    }
+    _limbs.insert(_limbs.begin(), limb_shift, 0u);
+    return *this;
+  }
+
+  big_uint&
+  operator>>=(const size_t n)
+  {
+    const size_t limb_shift = n / 32u;
+    const size_t bit_shift  = n % 32u;
+
+    if (_limbs.size() <= limb_shift) {
+      _limbs.clear();
+      return *this;
+    }
+    _limbs.erase(_limbs.begin(), _limbs.begin() + limb_shift);
+
+    if (bit_shift != 0u) {
+      for (size_t i = 0u; i < _limbs.size(); ++i) {
+        const uint32_t next = i + 1u < _limbs.size() ? _limbs[i + 1u] : 0u;
+        _limbs[i]           = (_limbs[i] >> bit_shift) | (next << (32u - bit_shift));
+      }
+    }
+    trim();
+    return *this;
+  }
+
+  friend big_uint
+  operator+(big_uint a, const big_uint& b)
+  {
+    return a += b;
+  }
+
+  friend big_uint
+  operator-(big_uint a, const big_uint& b)
+  {
+    return a -= b;
+  }
+
+  friend big_uint
+  operator<<(big_uint a, const size_t n)
+  {
+    return a <<= n;
+  }
+
+  friend bool
+  operator==(const big_uint& a, const big_uint& b)
+  {
+    return a._limbs == b._limbs;
+  }
+
+  friend bool
+  operator!=(const big_uint& a, const big_uint& b)
+  {
+    return !(a == b);
+  }
+
+  template <class Elem, class Traits>
+  friend std::basic_ostream<Elem, Traits>&
+  operator<<(std::basic_ostream<Elem, Traits>& os, const big_uint& x)
+  {
+    return os << x.to_string();
+  }
+
+private:
+  void
+  trim()
+  {
+    while (!_limbs.empty() && _limbs.back() == 0u) { _limbs.pop_back(); }
+  }
+};
+
+namespace detail
+{
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// \brief Exact number of satisfying assignments (or ZDD paths) by a single bottom-up traversal
+  ///        of the exported nodes of a decision diagram.
+  ///
+  /// \details The `View` provides read-only access to the nodes of a BDD package:
+  ///
+  ///          - `edge_type`:                Type of a (possibly complemented) edge.
+  ///          - `complement_edges`:         Whether edges may be complemented.
+  ///          - `regular(e)`:               Edge `e` without its complement flag.
+  ///          - `is_complemented(e)`:       Whether `e` carries the complement flag.
+  ///          - `is_terminal(e)`:           Whether the regular edge `e` is a terminal.
+  ///          - `terminal_value(e)`:        The value of the regular terminal `e`.
+  ///          - `level(e)`, `low(e)`, ...:  The level and children of the regular node `e`.
+  ///          - `id(e)`:                    A unique identifier of the regular node `e`.
+  ///
+  ///          The count of each node is memoised on its regular identifier and the traversal uses
+  ///          an explicit stack, i.e. it neither recurses on the (possibly very deep) diagram nor
+  ///          relies on the package's own computed table.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  template <bool is_zdd, typename View>
+  big_uint
+  count_exact_impl(const View& view, const typename View::edge_type root, const size_t varcount)
+  {
+    using edge_type = typename View::edge_type;
+
+    const auto regular = [&view](const edge_type e) -> edge_type {
+      if constexpr (View::complement_edges) {
+        return view.regular(e);
+      } else {
+        return e;
+      }
+    };
+
+    const auto is_complemented = [&view](const edge_type e) -> bool {
+      if constexpr (View::complement_edges) {
+        return view.is_complemented(e);
+      } else {
+        return false;
+      }
+    };
+
+    const auto level = [&](const edge_type reg) -> size_t {
+      return view.is_terminal(reg) ? varcount : static_cast<size_t>(view.level(reg));
+    };
+
+    std::unordered_map<uint64_t, big_uint> memo;
+
+    // Count of the edge `e` over all levels from `e`'s own level and downwards.
+    const auto edge_count = [&](const edge_type e) -> big_uint {
+      const edge_type reg = regular(e);
+
+      big_uint res = view.is_terminal(reg) ? big_uint(view.terminal_value(reg) ? 1u : 0u)
+                                           : memo.find(view.id(reg))->second;
+
+      if (is_complemented(e)) { res = big_uint::pow2(varcount - level(reg)) - res; }
+      return res;
+    };
+
+    // Count of the edge `e` as a child of a node at level `l`.
+    const auto child_count = [&](const edge_type e, const size_t l) -> big_uint {
+      big_uint res = edge_count(e);
+      if constexpr (!is_zdd) {
+        const size_t child_level = level(regular(e));
+        assert(l < child_level);
+        res <<= child_level - l - 1u;
+      }
+      return res;
+    };
+
+    const edge_type root_reg = regular(root);
+    if (!view.is_terminal(root_reg)) {
+      std::vector<edge_type> stack;
+      stack.push_back(root_reg);
+
+      while (!stack.empty()) {
+        const edge_type n = stack.back();
+        if (memo.find(view.id(n)) != memo.end()) {
+          stack.pop_back();
+          continue;
+        }
+
+        const edge_type low  = view.low(n);
+        const edge_type high = view.high(n);
+
+        bool pending = false;
+        for (const edge_type child : { regular(low), regular(high) }) {
+          if (!view.is_terminal(child) && memo.find(view.id(child)) == memo.end()) {
+            stack.push_back(child);
+            pending = true;
+          }
+        }
+        if (pending) { continue; }
+
+        stack.pop_back();
+
+        const size_t l = is_zdd ? 0u : level(n);
+        memo.emplace(view.id(n), child_count(low, l) + child_count(high, l));
+      }
+    }
+
+    big_uint res = edge_count(root);
+    if constexpr (!is_zdd) { res <<= level(root_reg); }
+    return res;
+  }
+}
+
+/// \brief Exact number of satisfying assignments of the BDD `root` over `vc` variables.
+///
+/// \details The BDD is counted over all `varcount` levels of its package, after which the count is
+///          adjusted to `vc` variables, i.e. `f` is assumed not to depend on the remaining ones.
+template <typename View>
+big_uint
+bdd_satcount_exact(const View& view,
+                   const typename View::edge_type root,
+                   const size_t varcount,
+                   const size_t vc)
+{
+  big_uint res = detail::count_exact_impl<false>(view, root, varcount);
+  if (vc < varcount) {
+    res >>= varcount - vc;
+  } else {
+    res <<= vc - varcount;
+  }
+  return res;
+}
+
+/// \brief Exact number of sets in the family of the ZDD `root`.
+template <typename View>
+big_uint
+zdd_satcount_exact(const View& view, const typename View::edge_type root)
+{
+  return detail::count_exact_impl<true>(view, root, 0u);
+}
+
+#endif // BDD_BENCHMARK_COMMON_SATCOUNT_H
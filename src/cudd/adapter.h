@@ -1,4 +1,5 @@
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <functional>
@@ -6,8 +7,10 @@
 #include <limits>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "../common/adapter.h"
+#include "../common/satcount.h"
 
 #include "cudd.h"
 #include "cuddObj.hh"
@@ -35,6 +38,64 @@ protected:
   { /* Do nothing */
   }
 
+  /// \brief Read-only view on CUDD's nodes for `bdd_satcount_exact` and `zdd_satcount_exact`.
+  template <bool Complement>
+  struct node_view
+  {
+    using edge_type                        = DdNode*;
+    static constexpr bool complement_edges = Complement;
+
+    DdManager* mgr;
+
+    DdNode*
+    regular(DdNode* e) const
+    {
+      return Cudd_Regular(e);
+    }
+
+    bool
+    is_complemented(DdNode* e) const
+    {
+      return Cudd_IsComplement(e);
+    }
+
+    bool
+    is_terminal(DdNode* e) const
+    {
+      return Cudd_IsConstant(e);
+    }
+
+    bool
+    terminal_value(DdNode* e) const
+    {
+      return Cudd_V(e) != 0.0;
+    }
+
+    int
+    level(DdNode* e) const
+    {
+      return Cudd_ReadPerm(mgr, Cudd_NodeReadIndex(e));
+    }
+
+    DdNode*
+    low(DdNode* e) const
+    {
+      return Cudd_E(e);
+    }
+
+    DdNode*
+    high(DdNode* e) const
+    {
+      return Cudd_T(e);
+    }
+
+    uint64_t
+    id(DdNode* e) const
+    {
+      return reinterpret_cast<uintptr_t>(e);
+    }
+  };
+
 public:
   template <typename F>
   int
@@ -89,6 +150,11 @@ public:
 
   static constexpr bool complement_edges = true;
 
+  static constexpr bool thread_safe      = false;
+  static constexpr bool supports_rename  = true;
+  static constexpr bool supports_relnext = true;
+  static constexpr bool exact_satcount   = true;
+
 public:
   typedef ADD dd_t;
   typedef ADD build_node_t;
@@ -273,6 +339,13 @@ public:
     return (states.Permute(_permute_relprev.data()) & rel).ExistAbstract(_vars_relprev);
   }
 
+  inline ADD
+  rename(const ADD& f, const std::function<int(int)>& m)
+  {
+    std::vector<int> permute = rename_permutation(_varcount, f.SupportIndices(), m);
+    return f.Permute(permute.data());
+  }
+
   inline uint64_t
   nodecount(const ADD& f)
   {
@@ -291,6 +364,18 @@ public:
     return f.CountMinterm(vc);
   }
 
+  inline big_uint
+  satcount_exact(const ADD& f)
+  {
+    return this->satcount_exact(f, _varcount);
+  }
+
+  inline big_uint
+  satcount_exact(const ADD& f, const size_t vc)
+  {
+    return bdd_satcount_exact(node_view<false>{ _mgr.getManager() }, f.getNode(), _varcount, vc);
+  }
+
   inline ADD
   satone(const ADD& f)
   {
@@ -372,6 +457,11 @@ public:
 
   static constexpr bool complement_edges = true;
 
+  static constexpr bool thread_safe      = false;
+  static constexpr bool supports_rename  = true;
+  static constexpr bool supports_relnext = true;
+  static constexpr bool exact_satcount   = true;
+
 public:
   typedef BDD dd_t;
   typedef BDD build_node_t;
@@ -553,6 +643,13 @@ public:
     return states.Permute(_permute_relprev.data()).AndAbstract(rel, _vars_relprev);
   }
 
+  inline BDD
+  rename(const BDD& f, const std::function<int(int)>& m)
+  {
+    std::vector<int> permute = rename_permutation(_varcount, f.SupportIndices(), m);
+    return f.Permute(permute.data());
+  }
+
   inline uint64_t
   nodecount(const BDD& f)
   {
@@ -571,6 +668,18 @@ public:
     return f.CountMinterm(vc);
   }
 
+  inline big_uint
+  satcount_exact(const BDD& f)
+  {
+    return this->satcount_exact(f, _varcount);
+  }
+
+  inline big_uint
+  satcount_exact(const BDD& f, const size_t vc)
+  {
+    return bdd_satcount_exact(node_view<true>{ _mgr.getManager() }, f.getNode(), _varcount, vc);
+  }
+
   inline BDD
   satone(const BDD& f)
   {
@@ -656,6 +765,11 @@ public:
 
   static constexpr bool complement_edges = false;
 
+  static constexpr bool thread_safe      = false;
+  static constexpr bool supports_rename  = false;
+  static constexpr bool supports_relnext = false;
+  static constexpr bool exact_satcount   = true;
+
 public:
   typedef ZDD dd_t;
   typedef ZDD build_node_t;
@@ -825,6 +939,18 @@ public:
     return f.CountMinterm(vc);
   }
 
+  inline big_uint
+  satcount_exact(const ZDD& f)
+  {
+    return this->satcount_exact(f, _varcount);
+  }
+
+  inline big_uint
+  satcount_exact(const ZDD& f, const size_t /*vc*/)
+  {
+    return zdd_satcount_exact(node_view<false>{ _mgr.getManager() }, f.getNode());
+  }
+
   inline std::vector<std::pair<int, char>>
   pickcube(const ZDD& f)
   {
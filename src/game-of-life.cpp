@@ -1,11 +1,19 @@
+// Algorithms
+#include <algorithm>
+
 // Assertions
 #include <cassert>
 
+// Concurrency
+#include <atomic>
+
 // Data Structures
+#include <optional>
 #include <set>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 // Types
 #include <cstdlib>
@@ -60,20 +68,129 @@ to_string(const symmetry& s)
 
 symmetry sym = symmetry::none;
 
+/// \brief Enum for choosing the order of conjunctions and quantifications.
+enum schedule
+{
+  /** Conjoin top and bottom half, then quantify everything */
+  halves,
+  /** Sweep all rows and quantify each row as soon as possible */
+  chain,
+};
+
+/// \brief Human-Friendly print
+std::string
+to_string(const schedule& s)
+{
+  switch (s) {
+  case schedule::halves: return "Halves";
+  case schedule::chain: return "Chain";
+  default: return "Unknown";
+  }
+}
+
+schedule sched = schedule::halves;
+
+bool parallel = false;
+
+/// \brief Enum for choosing what lies beyond the edges of the grid.
+enum boundary
+{
+  /** Surrounded by an unconstrained border of cells */
+  open,
+  /** Opposite edges are glued together */
+  torus,
+};
+
+/// \brief Human-Friendly print
+std::string
+to_string(const boundary& b)
+{
+  switch (b) {
+  case boundary::open: return "Open";
+  case boundary::torus: return "Torus";
+  default: return "Unknown";
+  }
+}
+
+boundary grid_boundary = boundary::open;
+
+/// \brief Number of alive neighbours for a dead cell to become alive.
+std::set<int> rule_birth = { 3 };
+
+/// \brief Number of alive neighbours for an alive cell to stay alive.
+std::set<int> rule_survival = { 2, 3 };
+
+/// \brief Human-Friendly print of the rule in B/S notation.
+std::string
+rule_string()
+{
+  std::string res = "B";
+  for (const int n : rule_birth) { res += static_cast<char>('0' + n); }
+  res += "/S";
+  for (const int n : rule_survival) { res += static_cast<char>('0' + n); }
+  return res;
+}
+
+/// \brief Parse a Life-like rule in B/S notation, e.g. 'B3/S23' or 'B36/S23'.
+///
+/// \returns Whether the rule could not be parsed.
+bool
+parse_rule(const std::string& rule)
+{
+  std::set<int> birth, survival;
+  std::set<int>* digits = nullptr;
+
+  for (const char c : ascii_tolower(rule)) {
+    if (c == 'b') {
+      digits = &birth;
+    } else if (c == 's') {
+      digits = &survival;
+    } else if (c == '/' && digits == &birth) {
+      continue;
+    } else if ('0' <= c && c <= '8' && digits != nullptr) {
+      digits->insert(c - '0');
+    } else {
+      return true;
+    }
+  }
+  if (digits == nullptr) { return true; }
+
+  rule_birth    = std::move(birth);
+  rule_survival = std::move(survival);
+  return false;
+}
+
 class parsing_policy
 {
 public:
   static constexpr std::string_view name = "Game of Life (Garden-of-Eden)";
-  static constexpr std::string_view args = "n:s:";
+  static constexpr std::string_view args = "b:n:pq:r:s:";
 
   static constexpr std::string_view help_text =
+    "        -b BOUNDARY  [open]   Cells beyond the edges of the grid (open/torus)\n"
     "        -n n         [4]      Size of grid\n"
+    "        -p                    Construct both halves of the grid in parallel\n"
+    "        -q SCHEDULE  [halves] Order of conjunctions and quantifications (halves/chain)\n"
+    "        -r RULE      [B3/S23] Life-like rule in B/S notation\n"
     "        -s SYMMETRY  [none]   Restriction to solutions with a symmetry";
 
   static inline bool
   parse_input(const int c, const char* arg)
   {
     switch (c) {
+    case 'b': {
+      const std::string lower_arg = ascii_tolower(arg);
+
+      if (is_prefix(lower_arg, "open")) {
+        grid_boundary = boundary::open;
+      } else if (is_prefix(lower_arg, "torus") || is_prefix(lower_arg, "toroidal")) {
+        grid_boundary = boundary::torus;
+      } else {
+        std::cerr << "Undefined boundary: " << arg << "\n";
+        return true;
+      }
+      return false;
+    }
     case 'n': {
       const int N = std::stoi(arg);
       if (N <= 0) {
@@ -87,6 +204,30 @@ public:
       }
       return false;
     }
+    case 'p': {
+      parallel = true;
+      return false;
+    }
+    case 'q': {
+      const std::string lower_arg = ascii_tolower(arg);
+
+      if (is_prefix(lower_arg, "halves")) {
+        sched = schedule::halves;
+      } else if (is_prefix(lower_arg, "chain")) {
+        sched = schedule::chain;
+      } else {
+        std::cerr << "Undefined schedule: " << arg << "\n";
+        return true;
+      }
+      return false;
+    }
+    case 'r': {
+      if (parse_rule(arg)) {
+        std::cerr << "Undefined rule: " << arg << "\n";
+        return true;
+      }
+      return false;
+    }
     case 's': {
       const std::string lower_arg = ascii_tolower(arg);
 
@@ -129,46 +270,53 @@ enum prime : bool
 
 // ============================================================================================== //
 
+/// \brief Whether the unprimed variables include a border around the primed ones.
+inline bool
+has_border(bool p = false)
+{
+  return !p && grid_boundary == boundary::open;
+}
+
 /// \brief Number of rows (depending on primality)
 inline int
 rows(bool p = false)
 {
-  return N_rows + 2 * (!p);
+  return N_rows + 2 * has_border(p);
 }
 
 /// \param p Whether the variable is primed.
 inline int
 MIN_ROW(bool p = false)
 {
-  return p;
+  return !has_border(p);
 }
 
 /// \param p Whether the variable is primed.
 inline int
 MAX_ROW(bool p = false)
 {
-  return rows(p) - (!p);
+  return MIN_ROW(p) + rows(p) - 1;
 }
 
 /// \brief Number of columns (depending on primality)
 inline int
 cols(bool p = false)
 {
-  return N_cols + 2 * (!p);
+  return N_cols + 2 * has_border(p);
 }
 
 /// \param p Whether the variable is primed.
 inline int
 MIN_COL(bool p = false)
 {
-  return p;
+  return !has_border(p);
 }
 
 /// \param p Whether the variable is primed.
 inline int
 MAX_COL(bool p = false)
 {
-  return cols(p) - (!p);
+  return MIN_COL(p) + cols(p) - 1;
 }
 
 /// \brief Whether the input size describes a sqaure board.
@@ -271,18 +419,20 @@ public:
       || this->col() < MIN_COL(this->prime()) || MAX_COL(this->prime()) < this->col();
   }
 
-  /// \brief Vertical distance between two cells
+  /// \brief Vertical distance between two cells (possibly wrapping around a torus)
   size_t
   vertical_dist_to(const cell& o) const
   {
-    return std::abs(this->row() - o.row());
+    const int dist = std::abs(this->row() - o.row());
+    return grid_boundary == boundary::torus ? std::min(dist, rows() - dist) : dist;
   }
 
-  /// \brief Horizontal distance between two cells
+  /// \brief Horizontal distance between two cells (possibly wrapping around a torus)
   size_t
   horizontal_dist_to(const cell& o) const
   {
-    return std::abs(this->col() - o.col());
+    const int dist = std::abs(this->col() - o.col());
+    return grid_boundary == boundary::torus ? std::min(dist, cols() - dist) : dist;
   }
 
   /// \brief Whether one cell is in the neighbourhood surrounding *this* cell.
@@ -305,10 +455,13 @@ public:
   /// \brief All unprimed cells that are in the neighbourhood of *this* cell.
   ///
   /// \details The returned list is in ascending row-major order.
+  ///
+  /// \remark This does not wrap around the edges of a toroidal grid.
   std::vector<cell>
   neighbourhood() const
   {
     assert(this->prime() == prime::post);
+    assert(grid_boundary == boundary::open);
 
     std::vector<cell> res = { cell(this->row() - 1, this->col() - 1, prime::pre),
                               cell(this->row() - 1, this->col(), prime::pre),
@@ -938,10 +1091,13 @@ public:
 //                         - [Wikipedia 'https://en.wikipedia.org/wiki/Conway%27s_Game_of_Life']
 
 /// \brief Accumulated time for all apply (and negation) operations
-time_duration goe__apply_time = 0;
+std::atomic<time_duration> goe__apply_time = 0;
 
 /// \brief Accumulated time for all existential quantification operations
-time_duration goe__exists_time = 0;
+std::atomic<time_duration> goe__exists_time = 0;
+
+/// \brief Accumulated time for all variable renaming operations
+std::atomic<time_duration> goe__rename_time = 0;
 
 /// \brief Decision Diagram that is `true` if exactly `alive` neighbour cells around `c` (including
 ///        itself) are alive at the 'unprimed' time.
@@ -1003,10 +1159,10 @@ construct_count(Adapter& adapter, const var_map& vm, const cell& c, const int al
   return adapter.build();
 }
 
-/// \brief Decision Diagram that is `true` if cell's state is preserved.
+/// \brief Decision Diagram that is `true` if cell's state is preserved (or flipped if `negated`).
 template <typename Adapter>
 typename Adapter::dd_t
-construct_eq(Adapter& adapter, const var_map& vm, const cell& c)
+construct_eq(Adapter& adapter, const var_map& vm, const cell& c, const bool negated = false)
 {
   const int x_pre  = vm[cell(c, prime::pre)];
   const int x_post = vm[cell(c, prime::post)];
@@ -1035,7 +1191,8 @@ construct_eq(Adapter& adapter, const var_map& vm, const cell& c)
   // 'x_pre'
   assert(x_pre == x);
 
-  root0 = adapter.build_node(x, root0, std::move(root1));
+  root0 = negated ? adapter.build_node(x, std::move(root1), root0)
+                 : adapter.build_node(x, root0, std::move(root1));
 
   // above 'x_pre'
   x -= 1;
@@ -1045,6 +1202,36 @@ construct_eq(Adapter& adapter, const var_map& vm, const cell& c)
   return adapter.build();
 }
 
+/// \brief The possible outcomes for the inner field, given the sum of all fields in its
+///        neighbourhood.
+enum outcome
+{
+  /** The inner field will be dead */
+  dead,
+  /** The inner field will become alive */
+  alive,
+  /** The inner field retains its state */
+  retain,
+  /** The inner field flips its state */
+  flip,
+};
+
+/// \brief Outcome of the rule (in B/S notation) for the sum of all fields in a neighbourhood.
+///
+/// \details If the inner field is dead, then the sum is its number of alive neighbours; if it is
+///          alive, then it has one fewer alive neighbours.
+outcome
+rule_outcome(const int sum)
+{
+  const bool birth    = rule_birth.count(sum) > 0;
+  const bool survival = 0 < sum && rule_survival.count(sum - 1) > 0;
+
+  if (birth && survival) { return outcome::alive; }
+  if (survival) { return outcome::retain; }
+  if (birth) { return outcome::flip; }
+  return outcome::dead;
+}
+
 /// \brief Combine decision diagrams together into transition relation for a single cell.
 template <typename Adapter>
 typename Adapter::dd_t
@@ -1052,26 +1239,54 @@ acc_rel(Adapter& adapter, const var_map& vm, const cell& c)
 {
   const int c_post_var = vm[cell(c, prime::post)];
 
-  const typename Adapter::dd_t alive_3 = construct_count(adapter, vm, c, 3);
-  const typename Adapter::dd_t alive_4 = construct_count(adapter, vm, c, 4);
+  typename Adapter::dd_t out = adapter.top();
 
-  typename Adapter::dd_t out;
+  // Sums for which the inner field is not dead.
+  typename Adapter::dd_t not_dead = adapter.bot();
 
-  { // -----------------------------------------------------------------------------------------------
-    // - If the sum is 3, the inner cell will become alive.
-    const typename Adapter::dd_t alive_post = adapter.ithvar(c_post_var);
+  for (const outcome o : { outcome::alive, outcome::retain, outcome::flip }) {
+    std::optional<typename Adapter::dd_t> sums;
 
-    out = adapter.apply_imp(alive_3, std::move(alive_post));
-  }
-  { // -----------------------------------------------------------------------------------------------
-    // - If the sum is 4, the inner field retains its state.
-    const typename Adapter::dd_t eq = construct_eq(adapter, vm, c);
+    for (int sum = 0; sum <= c.neighbourhood_size(); ++sum) {
+      if (rule_outcome(sum) != o) { continue; }
+
+      const typename Adapter::dd_t alive_sum = construct_count(adapter, vm, c, sum);
+      sums = sums ? adapter.apply_or(*sums, alive_sum) : alive_sum;
+    }
+
+    if (!sums) { continue; }
+
+    switch (o) {
+    case outcome::alive: { // ---------------------------------------------------------------------
+      // - If the sum is 3 (for B3/S23), the inner cell will become alive.
+      const typename Adapter::dd_t alive_post = adapter.ithvar(c_post_var);
+
+      out &= adapter.apply_imp(*sums, std::move(alive_post));
+      break;
+    }
+    case outcome::retain: { // --------------------------------------------------------------------
+      // - If the sum is 4 (for B3/S23), the inner field retains its state.
+      const typename Adapter::dd_t eq = construct_eq(adapter, vm, c);
+
+      out &= adapter.apply_imp(*sums, std::move(eq));
+      break;
+    }
+    case outcome::flip: { // ----------------------------------------------------------------------
+      // - If the sum only is in B, the inner field becomes alive if it is dead (and vice versa).
+      const typename Adapter::dd_t neq = construct_eq(adapter, vm, c, true);
+
+      out &= adapter.apply_imp(*sums, std::move(neq));
+      break;
+    }
+    case outcome::dead:
+    default: break;
+    }
 
-    out &= adapter.apply_imp(alive_4, std::move(eq));
+    not_dead |= std::move(*sums);
   }
-  { // -----------------------------------------------------------------------------------------------
+  { // ---------------------------------------------------------------------------------------------
     // - Otherwise, the inner field is dead.
-    const typename Adapter::dd_t alive_other = ~(std::move(alive_3) | std::move(alive_4));
+    const typename Adapter::dd_t alive_other = ~std::move(not_dead);
     const typename Adapter::dd_t dead_post   = adapter.nithvar(c_post_var);
 
     out &= adapter.apply_imp(std::move(alive_other), std::move(dead_post));
@@ -1083,13 +1298,13 @@ acc_rel(Adapter& adapter, const var_map& vm, const cell& c)
 /// \brief Combine decision diagrams together into transition relation for an entire row.
 template <typename Adapter>
 typename Adapter::dd_t
-acc_rel(Adapter& adapter, const var_map& vm, const int row)
+acc_rel(Adapter& adapter, const var_map& vm, const int row, std::ostream& out = std::cout)
 {
   auto res = adapter.top();
 
 #ifdef BDD_BENCHMARK_STATS
-  std::cout << json::field("Rel [" + std::to_string(row) + "   ]")
-            << json::value(adapter.nodecount(res)) << json::comma << json::endl;
+  out << json::field("Rel [" + std::to_string(row) + "   ]") << json::value(adapter.nodecount(res))
+      << json::comma << json::endl;
 #endif // BDD_BENCHMARK_STATS
 
   const time_point t_apply__before = now();
@@ -1101,8 +1316,8 @@ acc_rel(Adapter& adapter, const var_map& vm, const int row)
     res &= acc_rel(adapter, vm, c);
 
 #ifdef BDD_BENCHMARK_STATS
-    std::cout << json::field("Rel [" + c.to_string() + "+]") << json::value(adapter.nodecount(res))
-              << json::comma << json::endl;
+    out << json::field("Rel [" + c.to_string() + "+]") << json::value(adapter.nodecount(res))
+        << json::comma << json::endl;
 #endif // BDD_BENCHMARK_STATS
   }
 
@@ -1112,13 +1327,103 @@ acc_rel(Adapter& adapter, const var_map& vm, const int row)
   return res;
 }
 
+/// \brief Transition relations for entire rows.
+///
+/// \details Without any symmetry, the transition relations of all rows are identical up to the
+///          variables they are defined on. Hence, if the BDD package supports renaming variables,
+///          the relation for the first row is computed once and then shifted down to every other
+///          row. Otherwise, each row's relation is computed from scratch. On a torus, the shift
+///          wraps around and so does not preserve the variable order.
+///
+///          Computing a row from scratch uses the adapter's builder, which is shared by all
+///          threads. Hence, if `precompute` is set, then all such rows are computed upfront, such
+///          that the relations can afterwards be obtained from multiple threads.
+template <typename Adapter>
+class row_relations
+{
+private:
+  Adapter& _adapter;
+  const var_map& _vm;
+
+  /// \brief Transition relation of the first row (if it is reused)
+  std::optional<typename Adapter::dd_t> _first_row;
+
+  /// \brief Transition relations of all rows (if precomputed)
+  std::vector<typename Adapter::dd_t> _rows;
+
+public:
+  row_relations(Adapter& adapter, const var_map& vm, const bool precompute = false)
+    : _adapter(adapter)
+    , _vm(vm)
+  {
+    if constexpr (Adapter::supports_rename) {
+      if (vm.sym() == symmetry::none && grid_boundary == boundary::open) {
+        _first_row = acc_rel(adapter, vm, MIN_ROW(prime::post));
+#ifdef BDD_BENCHMARK_STATS
+        std::cout << json::endl;
+#endif // BDD_BENCHMARK_STATS
+      }
+    }
+
+    if (precompute && !_first_row) {
+      _rows.reserve(rows(prime::post));
+      for (int row = MIN_ROW(prime::post); row <= MAX_ROW(prime::post); ++row) {
+        _rows.push_back(acc_rel(adapter, vm, row));
+#ifdef BDD_BENCHMARK_STATS
+        std::cout << json::endl;
+#endif // BDD_BENCHMARK_STATS
+      }
+    }
+  }
+
+  /// \brief Transition relation for the given row (with statistics printed to `out`).
+  typename Adapter::dd_t
+  operator()(const int row, std::ostream& out = std::cout) const
+  {
+    if (!_rows.empty()) { return _rows[row - MIN_ROW(prime::post)]; }
+    if (!_first_row) { return acc_rel(_adapter, _vm, row, out); }
+
+    const int offset = row - MIN_ROW(prime::post);
+    if (offset == 0) { return *_first_row; }
+
+    // Move every cell `offset` rows down. All cells in the first row's relation have a shifted
+    // counterpart and their order is preserved. Cells that would be moved outside of the grid are
+    // not part of it; these are moved into the vacated cells to obtain a permutation.
+    std::vector<int> inside;
+    for (int x = 0; x < _vm.varcount(); ++x) {
+      const cell c = _vm[x];
+      if (c.row() + offset <= MAX_ROW(c.prime())) { inside.push_back(x); }
+    }
+
+    const std::vector<int> shift =
+      rename_permutation(_vm.varcount(), inside, [this, offset](const int x) {
+        const cell c = _vm[x];
+        return _vm[cell(c.row() + offset, c.col(), c.prime())];
+      });
+
+    const time_point t_rename__before = now();
+    const auto res = _adapter.rename(*_first_row, [&shift](int x) { return shift[x]; });
+    const time_point t_rename__after  = now();
+    goe__rename_time += duration_ms(t_rename__before, t_rename__after);
+
+#ifdef BDD_BENCHMARK_STATS
+    out << json::field("Ren [" + std::to_string(row) + "   ]")
+        << json::value(_adapter.nodecount(res)) << json::comma << json::endl;
+#endif // BDD_BENCHMARK_STATS
+
+    return res;
+  }
+};
+
 /// \brief Combine decision diagrams together into transition relation for top/bottom half of grid.
 template <typename Adapter>
 typename Adapter::dd_t
-acc_rel(Adapter& adapter, const var_map& vm, const bool bottom)
+acc_rel(Adapter& adapter,
+        const var_map& vm,
+        const row_relations<Adapter>& row_rels,
+        const bool bottom,
+        std::ostream& out = std::cout)
 {
-  // TODO (symmetry::none): Use Manual Variable Reordering to only compute a row once.
-
   const int half_rows = rows(prime::post) / 2;
 
   const int top_begin = MIN_ROW(prime::post);
@@ -1134,7 +1439,7 @@ acc_rel(Adapter& adapter, const var_map& vm, const bool bottom)
 
   for (int row = begin; bottom ? end <= row : row <= end; bottom ? --row : ++row) {
     // ---------------------------------------------------------------------------------------------
-    const auto row_rel = acc_rel(adapter, vm, row);
+    const auto row_rel = row_rels(row, out);
 
     const time_point t_apply__before = now();
     res &= std::move(row_rel);
@@ -1142,14 +1447,15 @@ acc_rel(Adapter& adapter, const var_map& vm, const bool bottom)
     goe__apply_time += duration_ms(t_apply__before, t_apply__after);
 
 #ifdef BDD_BENCHMARK_STATS
-    std::cout << json::field("Acc [" + std::to_string(begin) + "-" + std::to_string(row) + "]")
-              << json::value(adapter.nodecount(res)) << json::comma << json::endl;
+    out << json::field("Acc [" + std::to_string(begin) + "-" + std::to_string(row) + "]")
+        << json::value(adapter.nodecount(res)) << json::comma << json::endl;
 #endif // BDD_BENCHMARK_STATS
 
     // ---------------------------------------------------------------------------------------------
     // NOTE: Since all transition relations are very local, the complexity of the problem is hidden
     //       within the quantification. Hence, the decision diagram explodes during this operation.
-    //       The exception is, that we can quantify the top-most and two bottom-most rows early.
+    //       The exception is, that we can quantify the top-most and two bottom-most rows early
+    //       (unless the grid is a torus, where these rows also are neighbours of the other half).
     //
     //       - The top-most, resp. bottom-most, row of `prime::pre` is only used by the top-most,
     //         resp. bottom-most, row for `prime::post`. Hence, we can make the decision diagram it
@@ -1164,7 +1470,7 @@ acc_rel(Adapter& adapter, const var_map& vm, const bool bottom)
     //         comparing their values.
     const int quant_row = row + (bottom ? +1 : -1);
 
-    if (bottom ? begin <= quant_row : quant_row < begin) {
+    if (grid_boundary == boundary::open && (bottom ? begin <= quant_row : quant_row < begin)) {
       const time_point t_exists__before = now();
       res                               = adapter.exists(res, [&quant_row, &vm](int x) -> bool {
         return vm[x].prime() == prime::pre && vm[x].row() == quant_row;
@@ -1174,14 +1480,14 @@ acc_rel(Adapter& adapter, const var_map& vm, const bool bottom)
       goe__exists_time += duration_ms(t_exists__before, t_exists__after);
 
 #ifdef BDD_BENCHMARK_STATS
-      std::cout << json::field("Exi [" + std::to_string(quant_row) + "]")
-                << json::value(adapter.nodecount(res)) << json::comma << json::endl;
+      out << json::field("Exi [" + std::to_string(quant_row) + "]")
+          << json::value(adapter.nodecount(res)) << json::comma << json::endl;
 #endif // BDD_BENCHMARK_STATS
     }
 
     if (row != end) {
 #ifdef BDD_BENCHMARK_STATS
-      std::cout << json::endl;
+      out << json::endl;
 #endif // BDD_BENCHMARK_STATS
     }
   }
@@ -1189,42 +1495,11 @@ acc_rel(Adapter& adapter, const var_map& vm, const bool bottom)
   return res;
 }
 
-/// \brief Combine decision diagrams together into transition relation for entire grid and then
-///        quantify out all previous-state variables.
+/// \brief Quantify out all previous-state variables of the transition relation for the entire grid.
 template <typename Adapter>
 typename Adapter::dd_t
-garden_of_eden(Adapter& adapter, const var_map& vm)
+garden_of_eden__quantify(Adapter& adapter, const var_map& vm, typename Adapter::dd_t res)
 {
-#ifdef BDD_BENCHMARK_STATS
-  std::cout << json::field("intermediate results") << json::brace_open << json::endl;
-#endif // BDD_BENCHMARK_STATS
-
-  // -----------------------------------------------------------------------------------------------
-  // Top half
-  auto res = acc_rel(adapter, vm, false);
-
-  // -----------------------------------------------------------------------------------------------
-  // Bottom half
-  //
-  // TODO (symmetry::none): Use Reordering to obtain Top Half from Bottom Half (or vica versa).
-#ifdef BDD_BENCHMARK_STATS
-  std::cout << json::endl;
-#endif // BDD_BENCHMARK_STATS
-  res &= acc_rel(adapter, vm, true);
-
-  // -----------------------------------------------------------------------------------------------
-  // Middle row between halfs (if any)
-  if (rows(prime::post) % 2 == 1) {
-#ifdef BDD_BENCHMARK_STATS
-    std::cout << json::endl;
-#endif // BDD_BENCHMARK_STATS
-    res &= acc_rel(adapter, vm, rows(prime::post) / 2 + 1);
-
-#ifdef BDD_BENCHMARK_STATS
-    std::cout << json::endl;
-#endif // BDD_BENCHMARK_STATS
-  }
-
   // -----------------------------------------------------------------------------------------------
   // Final Merge
 #ifdef BDD_BENCHMARK_STATS
@@ -1272,12 +1547,205 @@ garden_of_eden(Adapter& adapter, const var_map& vm)
   return res;
 }
 
+/// \brief Combine decision diagrams together into transition relation for entire grid and then
+///        quantify out all previous-state variables.
+template <typename Adapter>
+typename Adapter::dd_t
+garden_of_eden__halves(Adapter& adapter, const var_map& vm)
+{
+#ifdef BDD_BENCHMARK_STATS
+  std::cout << json::field("intermediate results") << json::brace_open << json::endl;
+#endif // BDD_BENCHMARK_STATS
+
+  // NOTE: If reused, the first row is computed here, i.e., before any tasks below are started. The
+  //       same applies to all rows, if they cannot be reused and are to be used concurrently.
+  const row_relations<Adapter> row_rels(adapter, vm, Adapter::thread_safe && parallel);
+
+  const bool has_middle = rows(prime::post) % 2 == 1;
+  const int middle_row  = rows(prime::post) / 2 + 1;
+
+  if constexpr (Adapter::thread_safe) {
+    if (parallel) {
+      // -------------------------------------------------------------------------------------------
+      // Top half, bottom half, and middle row (if any) as concurrent tasks. To not interleave their
+      // statistics, these are buffered and only printed afterwards.
+      std::optional<typename Adapter::dd_t> top_half, bottom_half, middle;
+      std::stringstream top_out, bottom_out, middle_out;
+
+      adapter.par(
+        [&]() {
+          top_half = acc_rel(adapter, vm, row_rels, false, top_out);
+          return 0;
+        },
+        [&]() {
+          adapter.par(
+            [&]() {
+              bottom_half = acc_rel(adapter, vm, row_rels, true, bottom_out);
+              return 0;
+            },
+            [&]() {
+              if (has_middle) { middle = row_rels(middle_row, middle_out); }
+              return 0;
+            });
+          return 0;
+        });
+
+#ifdef BDD_BENCHMARK_STATS
+      std::cout << top_out.str() << json::endl << bottom_out.str();
+      if (has_middle) { std::cout << json::endl << middle_out.str() << json::endl; }
+#endif // BDD_BENCHMARK_STATS
+
+      auto res = std::move(*top_half);
+      res &= std::move(*bottom_half);
+      if (has_middle) { res &= std::move(*middle); }
+
+      return garden_of_eden__quantify(adapter, vm, std::move(res));
+    }
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Top half
+  auto res = acc_rel(adapter, vm, row_rels, false);
+
+  // -----------------------------------------------------------------------------------------------
+  // Bottom half
+  //
+  // TODO (symmetry::none): Use Reordering to obtain Top Half from Bottom Half (or vica versa). The
+  //                        vertical mirroring does not preserve the variable order.
+#ifdef BDD_BENCHMARK_STATS
+  std::cout << json::endl;
+#endif // BDD_BENCHMARK_STATS
+  res &= acc_rel(adapter, vm, row_rels, true);
+
+  // -----------------------------------------------------------------------------------------------
+  // Middle row between halfs (if any)
+  if (has_middle) {
+#ifdef BDD_BENCHMARK_STATS
+    std::cout << json::endl;
+#endif // BDD_BENCHMARK_STATS
+    res &= row_rels(middle_row);
+
+#ifdef BDD_BENCHMARK_STATS
+    std::cout << json::endl;
+#endif // BDD_BENCHMARK_STATS
+  }
+
+  return garden_of_eden__quantify(adapter, vm, std::move(res));
+}
+
+/// \brief Conjoin the transition relation row by row and quantify each previous-state variable as
+///        soon as no later row depends on it (a relational product chain).
+///
+/// \details Instead of first constructing the relation for the entire grid, the intermediate result
+///          only describes the rows conjoined so far and the (one or two) `prime::pre` rows that
+///          are still shared with the remaining ones. With symmetries, some `prime::pre` variables
+///          are shared with far away rows and can only be quantified later.
+template <typename Adapter>
+typename Adapter::dd_t
+garden_of_eden__chain(Adapter& adapter, const var_map& vm)
+{
+#ifdef BDD_BENCHMARK_STATS
+  std::cout << json::field("intermediate results") << json::brace_open << json::endl;
+#endif // BDD_BENCHMARK_STATS
+
+  // -----------------------------------------------------------------------------------------------
+  // For each 'prime::pre' variable, the last 'prime::post' row that depends on it.
+  std::vector<int> last_use(vm.varcount(), MIN_ROW(prime::post) - 1);
+
+  for (int row = MIN_ROW(prime::pre); row <= MAX_ROW(prime::pre); ++row) {
+    const cell c_pre(row, MIN_COL(prime::pre), prime::pre);
+
+    int used_until = MIN_ROW(prime::post) - 1;
+    for (int post_row = MIN_ROW(prime::post); post_row <= MAX_ROW(prime::post); ++post_row) {
+      const cell c_post(post_row, MIN_COL(prime::post), prime::post);
+      if (c_post.vertical_dist_to(c_pre) <= 1) { used_until = post_row; }
+    }
+
+    for (int col = MIN_COL(prime::pre); col <= MAX_COL(prime::pre); ++col) {
+      const int x    = vm[cell(row, col, prime::pre)];
+      last_use.at(x) = std::max(last_use.at(x), used_until);
+    }
+  }
+
+  row_relations<Adapter> row_rels(adapter, vm);
+
+#ifdef BDD_BENCHMARK_STATS
+  size_t peak_nodes = 0;
+#endif // BDD_BENCHMARK_STATS
+
+  auto res = adapter.top();
+
+  for (int row = MIN_ROW(prime::post); row <= MAX_ROW(prime::post); ++row) {
+    [[maybe_unused]] const time_point t_step__before = now();
+
+    // ---------------------------------------------------------------------------------------------
+    const auto row_rel = row_rels(row);
+
+    const time_point t_apply__before = now();
+    res &= std::move(row_rel);
+    const time_point t_apply__after = now();
+    goe__apply_time += duration_ms(t_apply__before, t_apply__after);
+
+#ifdef BDD_BENCHMARK_STATS
+    const size_t acc_nodes = adapter.nodecount(res);
+    peak_nodes             = std::max(peak_nodes, acc_nodes);
+
+    std::cout << json::field("Acc [" + std::to_string(MIN_ROW(prime::post)) + "-"
+                             + std::to_string(row) + "]")
+              << json::value(acc_nodes) << json::comma << json::endl;
+#endif // BDD_BENCHMARK_STATS
+
+    // ---------------------------------------------------------------------------------------------
+    if (std::find(last_use.begin(), last_use.end(), row) != last_use.end()) {
+      const time_point t_exists__before = now();
+      res                               = adapter.exists(res, [&vm, &last_use, row](int x) -> bool {
+        return vm[x].prime() == prime::pre && last_use[x] == row;
+      });
+      const time_point t_exists__after  = now();
+      goe__exists_time += duration_ms(t_exists__before, t_exists__after);
+    }
+
+    [[maybe_unused]] const time_point t_step__after = now();
+
+#ifdef BDD_BENCHMARK_STATS
+    std::cout << json::field("Exi [" + std::to_string(row) + "]")
+              << json::value(adapter.nodecount(res)) << json::comma << json::endl;
+    std::cout << json::field("Time [" + std::to_string(row) + "] (ms)")
+              << json::value(duration_ms(t_step__before, t_step__after)) << json::comma
+              << json::endl;
+    std::cout << json::endl;
+#endif // BDD_BENCHMARK_STATS
+  }
+
+#ifdef BDD_BENCHMARK_STATS
+  std::cout << json::field("peak (nodes)") << json::value(peak_nodes) << json::endl;
+  std::cout << json::brace_close << json::comma << json::endl;
+#endif // BDD_BENCHMARK_STATS
+
+  return res;
+}
+
+/// \brief Set of `prime::post` states that have a predecessor, i.e., are not Garden of Edens.
+template <typename Adapter>
+typename Adapter::dd_t
+garden_of_eden(Adapter& adapter, const var_map& vm)
+{
+  switch (sched) {
+  case schedule::chain: return garden_of_eden__chain(adapter, vm);
+  case schedule::halves:
+  default: return garden_of_eden__halves(adapter, vm);
+  }
+}
+
 // ============================================================================================== //
 //                                             EXPECTED                                           //
 //
 // For all solvable sizes, we expect to find 'no solution exists'. That is, we expect ALL initial
 // states to have at least one predecessor. That is, the above `garden_of_eden(...)` function should
 // return a decision diagram that is true for all assignments to the `prime::post` variables.
+//
+// This only is known for Conway's rule (B3/S23) on an open grid. For other rules and for a torus,
+// Garden of Edens may very well exist.
 
 /// \brief Decision Diagram that is `true` for any assignment to `prime::post` variables.
 template <typename Adapter>
@@ -1307,6 +1775,17 @@ run_gameoflife(int argc, char** argv)
   if (N_rows < 0) { N_rows = 4; }
   if (N_cols < 0) { N_cols = N_rows; }
 
+  if (grid_boundary == boundary::torus) {
+    if (N_rows < 3 || N_cols < 3) {
+      std::cerr << "A toroidal grid must be at least 3x3.\n";
+      return -1;
+    }
+    if (sym != symmetry::none) {
+      std::cerr << "Symmetries are not supported for a toroidal grid.\n";
+      return -1;
+    }
+  }
+
   if (rows() < cols()) {
     std::cerr << "Note:\n"
               << "|   The variable ordering is designed for 'cols <= rows'.\n"
@@ -1320,8 +1799,16 @@ run_gameoflife(int argc, char** argv)
   return run<Adapter>("game-of-life", vm.varcount(), [&](Adapter& adapter) {
     std::cout << json::field("rows") << json::value(N_rows) << json::comma << json::endl;
     std::cout << json::field("cols") << json::value(N_cols) << json::comma << json::endl;
+    std::cout << json::field("rule") << json::value(rule_string()) << json::comma << json::endl;
+    std::cout << json::field("boundary") << json::value(to_string(grid_boundary)) << json::comma
+              << json::endl;
     std::cout << json::field("symmetry") << json::value(to_string(sym)) << json::comma
               << json::endl;
+    std::cout << json::field("schedule") << json::value(to_string(sched)) << json::comma
+              << json::endl;
+    std::cout << json::field("parallel")
+              << json::value(Adapter::thread_safe && parallel && sched == schedule::halves)
+              << json::comma << json::endl;
     std::cout << json::field("variables[prev]") << json::value(vm.varcount(prime::pre))
               << json::comma << json::endl;
     std::cout << json::field("variables[next]") << json::value(vm.varcount(prime::post))
@@ -1341,9 +1828,12 @@ run_gameoflife(int argc, char** argv)
 
     std::cout << json::field("time (ms)") << json::value(goe__total_time) << json::comma
               << json::endl;
-    std::cout << json::field("time[apply] (ms)") << json::value(goe__apply_time) << json::comma
+    std::cout << json::field("time[apply] (ms)") << json::value(goe__apply_time.load())
+              << json::comma << json::endl;
+    std::cout << json::field("time[exists] (ms)") << json::value(goe__exists_time.load())
+              << json::comma << json::endl;
+    std::cout << json::field("time[rename] (ms)") << json::value(goe__rename_time.load())
               << json::endl;
-    std::cout << json::field("time[exists] (ms)") << json::value(goe__exists_time) << json::endl;
 
     std::cout << json::brace_close << json::comma << json::endl;
 
@@ -1386,7 +1876,8 @@ run_gameoflife(int argc, char** argv)
     std::cout << json::field("total time (ms)") << json::value(init_time + total_time)
               << json::endl;
 
-    // For all solvable sizes, the number of solutions should be 0.
-    return solutions != 0;
+    // For all solvable sizes, the number of solutions should be 0 (with Conway's rule).
+    const bool conway = rule_string() == "B3/S23" && grid_boundary == boundary::open;
+    return conway && solutions != 0;
   });
 }
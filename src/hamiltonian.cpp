@@ -3,8 +3,11 @@
 
 // Data Structures
 #include <array>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 // Math, e.g. absolute and minimum value
 #include <cmath>
@@ -13,15 +16,21 @@
 #include <algorithm>
 
 // Types
+#include <cstdint>
 #include <cstdlib>
 
 // Other
+#include <filesystem>
+#include <fstream>
+#include <limits>
 #include <utility>
 
 #include "common/adapter.h"
 #include "common/array.h"
+#include "common/bandwidth.h"
 #include "common/chrono.h"
 #include "common/input.h"
+#include "common/satcount.h"
 
 #ifdef BDD_BENCHMARK_STATS
 size_t largest_bdd = 0;
@@ -40,7 +49,8 @@ enum encoding
   BINARY,
   UNARY,
   CRT__UNARY,
-  TIME
+  TIME,
+  FRONTIER
 };
 
 std::string
@@ -51,20 +61,51 @@ to_string(const encoding& e)
   case encoding::UNARY: return "Unary (One-hot)";
   case encoding::CRT__UNARY: return "Chinese Remainder Theorem: Unary (One-hot)";
   case encoding::TIME: return "Time-based";
+  case encoding::FRONTIER: return "Frontier-based Search";
   default: return "Unknown";
   }
 }
 
 encoding enc = encoding::TIME;
 
+/// \brief Path to a graph file to use instead of the grid graph.
+std::string graph_path = "";
+
+enum vertex_order
+{
+  INPUT,
+  CUTHILL_MCKEE,
+  SLOAN
+};
+
+std::string
+to_string(const vertex_order& vo)
+{
+  switch (vo) {
+  case vertex_order::INPUT: return "input";
+  case vertex_order::CUTHILL_MCKEE: return "cuthill-mckee";
+  case vertex_order::SLOAN: return "sloan";
+  default: return "Unknown";
+  }
+}
+
+vertex_order graph_order = vertex_order::CUTHILL_MCKEE;
+
+/// \brief Whether to count Hamiltonian Paths rather than Hamiltonian Cycles.
+bool count_paths = false;
+
 class parsing_policy
 {
 public:
   static constexpr std::string_view name = "Hamiltonian";
-  static constexpr std::string_view args = "n:e:";
+  static constexpr std::string_view args = "n:e:f:o:p";
 
-  static constexpr std::string_view help_text = "        -n n         [4]      Size of grid\n"
-                                                "        -e ENCODING  [time]   Problem encoding";
+  static constexpr std::string_view help_text =
+    "        -n n         [4]       Size of grid\n"
+    "        -e ENCODING  [time]    Problem encoding\n"
+    "        -f PATH                Path to graph file (DIMACS or edge list)\n"
+    "        -o ORDER     [cuthill] Vertex order of graph file (input/cuthill-mckee/sloan)\n"
+    "        -p                     Count Hamiltonian paths rather than cycles";
 
   static inline bool
   parse_input(const int c, const char* arg)
@@ -94,12 +135,45 @@ public:
         enc = encoding::CRT__UNARY;
       } else if (lower_arg == "time" || lower_arg == "t") {
         enc = encoding::TIME;
+      } else if (lower_arg == "frontier" || lower_arg == "simpath") {
+        enc = encoding::FRONTIER;
       } else {
         std::cerr << "Undefined option: " << arg << "\n";
         return true;
       }
       return false;
     }
+    case 'f': {
+      if (!std::filesystem::exists(arg)) {
+        std::cerr << "File '" << arg << "' does not exist\n";
+        return true;
+      }
+      if (!graph_path.empty()) {
+        std::cerr << "Only one file may be given\n";
+        return true;
+      }
+      graph_path = arg;
+      return false;
+    }
+    case 'o': {
+      const std::string lower_arg = ascii_tolower(arg);
+
+      if (is_prefix(lower_arg, "input")) {
+        graph_order = vertex_order::INPUT;
+      } else if (is_prefix(lower_arg, "cuthill-mckee")) {
+        graph_order = vertex_order::CUTHILL_MCKEE;
+      } else if (is_prefix(lower_arg, "sloan")) {
+        graph_order = vertex_order::SLOAN;
+      } else {
+        std::cerr << "Undefined ordering: " << arg << "\n";
+        return true;
+      }
+      return false;
+    }
+    case 'p': {
+      count_paths = true;
+      return false;
+    }
     default: return true;
     }
   }
@@ -620,6 +694,176 @@ init_cells_descending()
   // std::sort<std::greater<cell>>(cells_descending.begin(), cells_descending.end());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//                               Graph logic                                  //
+////////////////////////////////////////////////////////////////////////////////
+
+/// \brief An undirected (simple) graph with vertices `0, 1, ..., vertices-1`.
+struct graph
+{
+  /// \brief Number of vertices.
+  int vertices = 0;
+
+  /// \brief Edges `(u,v)` with `u < v` in lexicographical order.
+  std::vector<std::pair<int, int>> edges;
+
+  /// \brief Sort the edges and remove duplicates.
+  void
+  normalize()
+  {
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  }
+};
+
+/// \brief The grid graph where each vertex is the `dd_var` of its cell.
+graph
+grid_graph()
+{
+  graph g;
+  g.vertices = cells();
+
+  for (int row = MIN_ROW(); row <= MAX_ROW(); ++row) {
+    for (int col = MIN_COL(); col <= MAX_COL(); ++col) {
+      const cell u(row, col);
+      for (const cell& v : u.neighbours()) {
+        if (u < v) { g.edges.push_back({ u.dd_var(), v.dd_var() }); }
+      }
+    }
+  }
+  g.normalize();
+  return g;
+}
+
+/// \brief Parse an undirected graph from a file.
+///
+/// \details Two formats are supported:
+///
+/// - DIMACS: A problem line `p edge <vertices> <edges>` (or `p col ...`)
+///   followed by lines `e <u> <v>` with vertices numbered `1, 2, ...,
+///   vertices`.
+///
+/// - Edge list: Lines `<u> <v>` with arbitrary non-negative vertex identifiers
+///   (further columns, e.g. weights, are ignored). Vertices are numbered in the
+///   order they first occur.
+///
+/// In both, lines starting with `c`, `#`, or `%` are comments. Self-loops are
+/// dropped, since they are never part of a Hamiltonian cycle (or path).
+std::optional<graph>
+parse_graph(const std::string& path)
+{
+  std::ifstream in(path);
+  if (!in.is_open()) {
+    std::cerr << "error: could not open '" << path << "'\n";
+    return std::nullopt;
+  }
+
+  graph g;
+  bool dimacs = false;
+  std::unordered_map<long long, int> ids;
+
+  std::string line;
+  for (int line_number = 1; std::getline(in, line); ++line_number) {
+    std::istringstream ls(line);
+
+    std::string head;
+    if (!(ls >> head) || head[0] == 'c' || head[0] == '#' || head[0] == '%') { continue; }
+
+    if (head == "p") {
+      std::string kind;
+      long long vertices = -1, edges = -1;
+      if (!(ls >> kind >> vertices >> edges) || (kind != "edge" && kind != "col") || vertices < 0
+          || std::numeric_limits<int>::max() < vertices || edges < 0) {
+        std::cerr << "error: expected `p edge #vertices #edges` (line " << line_number << ")\n";
+        return std::nullopt;
+      }
+      if (dimacs || !g.edges.empty()) {
+        std::cerr << "error: unexpected problem line (line " << line_number << ")\n";
+        return std::nullopt;
+      }
+      dimacs     = true;
+      g.vertices = vertices;
+      g.edges.reserve(edges);
+      continue;
+    }
+
+    if (head == "e") {
+      if (!dimacs) {
+        std::cerr << "error: edge before problem line (line " << line_number << ")\n";
+        return std::nullopt;
+      }
+      if (!(ls >> head)) {
+        std::cerr << "error: expected `e u v` (line " << line_number << ")\n";
+        return std::nullopt;
+      }
+    } else if (dimacs) {
+      std::cerr << "error: expected `e u v` (line " << line_number << ")\n";
+      return std::nullopt;
+    }
+
+    long long u = -1, v = -1;
+    std::istringstream us(head);
+    if (!(us >> u) || !(ls >> v) || u < 0 || v < 0) {
+      std::cerr << "error: expected two vertex identifiers (line " << line_number << ")\n";
+      return std::nullopt;
+    }
+
+    if (dimacs) {
+      if (u < 1 || g.vertices < u || v < 1 || g.vertices < v) {
+        std::cerr << "error: vertex out of range (line " << line_number << ")\n";
+        return std::nullopt;
+      }
+      u -= 1;
+      v -= 1;
+    } else {
+      u = ids.try_emplace(u, ids.size()).first->second;
+      v = ids.try_emplace(v, ids.size()).first->second;
+    }
+
+    if (u == v) { continue; }
+    g.edges.push_back({ std::min(u, v), std::max(u, v) });
+  }
+
+  if (in.bad()) {
+    std::cerr << "error: reading from the input file failed\n";
+    return std::nullopt;
+  }
+
+  if (!dimacs) { g.vertices = ids.size(); }
+  g.normalize();
+  return g;
+}
+
+/// \brief Relabel the vertices of a graph with the given ordering.
+///
+/// \details Like for the variables in *McNet*, both Cuthill-McKee and Sloan's
+///          algorithm minimise the bandwidth of the graph. Since the frontier
+///          of an edge only includes vertices between its two endpoints, this
+///          keeps the frontier small.
+graph
+reorder(const graph& g, const vertex_order& vo)
+{
+  if (vo == vertex_order::INPUT) { return g; }
+
+  const std::vector<int> order = bandwidth_ordering(g.vertices,
+                                                    g.edges,
+                                                    vo == vertex_order::CUTHILL_MCKEE
+                                                      ? bandwidth_order::CUTHILL_MCKEE
+                                                      : bandwidth_order::SLOAN__PSEUDO_PERIPHERAL);
+
+  std::vector<int> position(g.vertices);
+  for (int i = 0; i < g.vertices; ++i) { position[order[i]] = i; }
+
+  graph res;
+  res.vertices = g.vertices;
+  res.edges.reserve(g.edges.size());
+  for (const auto& [u, v] : g.edges) {
+    res.edges.push_back({ std::min(position[u], position[v]), std::max(position[u], position[v]) });
+  }
+  res.normalize();
+  return res;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Gadgets for the `encoding::BINARY` and `encoding::(CRT__)UNARY`
 ///        encodings.
@@ -1705,6 +1949,129 @@ namespace enc_gadgets
     return [=](const int x) { return cell_of_var(x, opt) == c && type_of_var(x, opt) == t; };
   }
 
+  /// \brief Variable substitution that moves all bits of a cell `shift` cells
+  ///        further in the variable ordering.
+  ///
+  /// \details Bits of cells that would be moved off the board are kept as-is.
+  ///          These are never part of the support of the shifted constraints.
+  inline int
+  shift_var(const int x, const int shift, const encoding& opt)
+  {
+    const int c = cell_of_var(x, opt).dd_var() + shift;
+    if (c < 0 || cells() <= c) { return x; }
+
+    return x + shift * (x < edge_vars(opt) ? 2 * bits_per_edge(opt) : 1);
+  }
+
+  /// \brief Cache of the constraints for each move, i.e. their *shape*.
+  ///
+  /// \details The constraints for two edges with the same move are identical up
+  ///          to moving all variables by the distance between the two edges.
+  ///          Hence, if the BDD package supports renaming, only the first
+  ///          constraint of each move is constructed. All others are derived
+  ///          from it by a (order-preserving) variable substitution.
+  template <typename Adapter>
+  class shape_cache
+  {
+  private:
+    Adapter& _adapter;
+    const encoding _opt;
+
+    /// \brief For each move, the first cell and its constraint.
+    std::unordered_map<int, std::pair<int, typename Adapter::dd_t>> _shapes;
+
+  public:
+    shape_cache(Adapter& adapter, const encoding& opt)
+      : _adapter(adapter)
+      , _opt(opt)
+    {}
+
+    /// \brief Obtain the constraint for the edge `e`, if need be constructed
+    ///        with `construct`.
+    template <typename Construct>
+    typename Adapter::dd_t
+    operator()(const edge& e, const Construct& construct)
+    {
+      if constexpr (Adapter::supports_rename) {
+        const auto it = _shapes.find(e.idx());
+        if (it == _shapes.end()) {
+          const typename Adapter::dd_t res = construct();
+          _shapes.insert({ e.idx(), { e.u().dd_var(), res } });
+          return res;
+        }
+
+        const int shift = e.u().dd_var() - it->second.first;
+        const encoding opt = _opt;
+
+        const typename Adapter::dd_t res = _adapter.rename(
+          it->second.second, [shift, opt](const int x) { return shift_var(x, shift, opt); });
+
+#ifdef BDD_BENCHMARK_STATS
+        const size_t nodecount = _adapter.nodecount(res);
+        largest_bdd            = std::max(largest_bdd, nodecount);
+        total_nodes += nodecount;
+#endif // BDD_BENCHMARK_STATS
+
+        return res;
+      } else {
+        return construct();
+      }
+    }
+  };
+
+  /// \brief Conjunction of the (independent) constraints in `[begin, end)` as
+  ///        a balanced tree.
+  ///
+  /// \details On thread-safe BDD packages, both halves are computed in
+  ///          parallel.
+  template <typename Adapter>
+  typename Adapter::dd_t
+  conjoin(Adapter& adapter,
+          const std::vector<typename Adapter::dd_t>& dds,
+          const size_t begin,
+          const size_t end)
+  {
+    if (begin == end) { return adapter.top(); }
+    if (begin + 1 == end) { return dds[begin]; }
+
+    const size_t mid = begin + (end - begin) / 2;
+
+    std::optional<typename Adapter::dd_t> lhs, rhs;
+    if constexpr (Adapter::thread_safe) {
+      adapter.par(
+        [&]() {
+          lhs = conjoin(adapter, dds, begin, mid);
+          return 0;
+        },
+        [&]() {
+          rhs = conjoin(adapter, dds, mid, end);
+          return 0;
+        });
+    } else {
+      lhs = conjoin(adapter, dds, begin, mid);
+      rhs = conjoin(adapter, dds, mid, end);
+    }
+    return adapter.apply_and(*lhs, *rhs);
+  }
+
+  /// \brief Conjunction of all (independent) constraints.
+  template <typename Adapter>
+  typename Adapter::dd_t
+  conjoin(Adapter& adapter, const std::vector<typename Adapter::dd_t>& dds)
+  {
+    const typename Adapter::dd_t res = conjoin(adapter, dds, 0, dds.size());
+
+#ifdef BDD_BENCHMARK_STATS
+    if (1 < dds.size()) {
+      const size_t nodecount = adapter.nodecount(res);
+      largest_bdd            = std::max(largest_bdd, nodecount);
+      total_nodes += nodecount;
+    }
+#endif // BDD_BENCHMARK_STATS
+
+    return res;
+  }
+
   /// \brief Encoding of the Hamiltonian Cycle problem given a non-zero number
   ///        of modulo values.
   ///
@@ -1810,29 +2177,36 @@ namespace enc_gadgets
 #ifdef BDD_BENCHMARK_STATS
     std::cout << json::field("match edge-indices") << json::brace_open << json::comma << json::endl;
 #endif // BDD_BENCHMARK_STATS
+    shape_cache<Adapter> match_cache(adapter, opt);
+
     for (int row = MAX_ROW(); 0 <= row; --row) {
       for (int col = MAX_COL(); 0 <= col; --col) {
         const cell u(row, col);
 
         // Skip (0,0) since both its ingoing and outgoing edges are fixed
         if (u != cell::special_0()) {
+          std::vector<typename Adapter::dd_t> constraints;
           for (const cell v : u.neighbours()) {
             const edge e(u, v);
 
             // Skip (0,0) since both its ingoing and outgoing edges are fixed
             if (v == cell::special_0()) { continue; }
 
-            paths &= match_u_v(adapter, e, opt);
+            constraints.push_back(match_cache(e, [&]() { return match_u_v(adapter, e, opt); }));
+          }
+
+          // All of `u`'s constraints are independent of `paths` and so can be
+          // combined before being applied to it.
+          paths &= conjoin(adapter, constraints);
 
 #ifdef BDD_BENCHMARK_STATS
-            const size_t nodecount = adapter.nodecount(paths);
-            largest_bdd            = std::max(largest_bdd, nodecount);
-            total_nodes += nodecount;
+          const size_t nodecount = adapter.nodecount(paths);
+          largest_bdd            = std::max(largest_bdd, nodecount);
+          total_nodes += nodecount;
 
-            std::cout << json::field("apply(" + e.to_string() + ")") << json::value(nodecount)
-                      << json::comma << json::endl;
+          std::cout << json::field("apply(" + u.to_string() + ")") << json::value(nodecount)
+                    << json::comma << json::endl;
 #endif // BDD_BENCHMARK_STATS
-          }
         }
 
         // Quantify the cell cell that is 'active_rows' below and one to the
@@ -1890,6 +2264,8 @@ namespace enc_gadgets
     // Add cycle length constraint(s) per modulo value
     const std::vector<int> ps = gadget_moduli(opt);
     for (const int p : ps) {
+      shape_cache<Adapter> gadget_cache(adapter, opt);
+
 #ifdef BDD_BENCHMARK_STATS
       std::cout << json::field("path length") << json::brace_open << json::endl;
       std::cout << json::field("modulo") << json::value(p) << json::comma << json::endl;
@@ -1996,20 +2372,22 @@ namespace enc_gadgets
                       << json::comma << json::endl;
 #endif // BDD_BENCHMARK_STATS
           } else {
+            std::vector<typename Adapter::dd_t> gadgets;
             for (const cell v : u.neighbours()) {
               const edge e(u, v);
+              gadgets.push_back(gadget_cache(e, [&]() { return gadget(adapter, e, p, opt); }));
+            }
 
-              paths &= gadget(adapter, e, p, opt);
+            paths &= conjoin(adapter, gadgets);
 
 #ifdef BDD_BENCHMARK_STATS
-              const size_t nodecount = adapter.nodecount(paths);
-              largest_bdd            = std::max(largest_bdd, nodecount);
-              total_nodes += nodecount;
+            const size_t nodecount = adapter.nodecount(paths);
+            largest_bdd            = std::max(largest_bdd, nodecount);
+            total_nodes += nodecount;
 
-              std::cout << json::field("gadget(" + e.to_string() + ")") << json::value(nodecount)
-                        << json::comma << json::endl;
+            std::cout << json::field("gadget(" + u.to_string() + ")") << json::value(nodecount)
+                      << json::comma << json::endl;
 #endif // BDD_BENCHMARK_STATS
-            }
 
             // Quantify a cell two rows above and one to the left of the
             // current; this one will never be relevant for later cells.
@@ -2432,6 +2810,294 @@ namespace enc_time
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Algorithms for the `encoding::FRONTIER` encoding
+///
+/// Frontier-based search [Knuth2011, Minato2017] with one variable per
+/// (undirected) edge of the graph. Here, the decision diagram is not obtained
+/// with any BDD operations. Instead, it is constructed top-down directly with
+/// `build_node`. To this end, the edges are processed in the order of their
+/// variables while one keeps track of the *frontier*, i.e., the vertices that
+/// are incident to both a processed and an unprocessed edge. Each node
+/// corresponds to a *mate* assignment for the frontier:
+///
+/// - A vertex with degree 0 is its own mate.
+/// - A vertex with degree 1 is mated with the other endpoint of its path.
+/// - A vertex with degree 2 is saturated.
+///
+/// Two edge sets with the same mate assignment have the same set of valid
+/// completions and so share the same node.
+///
+/// For Hamiltonian paths (see `-p`), a vertex may also leave the frontier with
+/// degree 1. The other endpoint of its path then is *anchored*, i.e., it is
+/// still of degree 1 but its mate is not part of the frontier anymore.
+///
+/// \remark This works equally well for BDDs and ZDDs, since all nodes on every
+///         path to the `true` terminal are created explicitly.
+////////////////////////////////////////////////////////////////////////////////
+namespace enc_frontier
+{
+  /// \brief Number of variables used in this encoding.
+  inline int
+  vars(const graph& g)
+  {
+    // Even a graph without edges needs one variable for the BDD package.
+    return std::max<int>(g.edges.size(), 1);
+  }
+
+  /// \brief Number of variables to use for final model count
+  inline int
+  satcount_vars(const graph& g)
+  {
+    return g.edges.size();
+  }
+
+  /// \brief Mate value of a saturated vertex.
+  constexpr char SATURATED = -1;
+
+  /// \brief Mate value of an anchored vertex.
+  constexpr char ANCHORED = -2;
+
+  /// \brief Child of a node that is the `false` terminal.
+  constexpr int64_t FALSE = -1;
+
+  /// \brief Child of a node that is the `true` terminal.
+  constexpr int64_t TRUE = -2;
+
+  /// \brief Frontier state where the cycle (or path) has been completed. All
+  ///        remaining edges are to be excluded.
+  ///
+  /// \details The mate assignments themselves are never empty.
+  const std::string DONE = "";
+
+  /// \brief The frontier (window of vertices) when processing each edge.
+  struct frontier
+  {
+    /// \brief For each vertex, the first and the last edge it is part of.
+    std::vector<int> first_edge, last_edge;
+
+    /// \brief For each edge, the smallest and largest vertex in its frontier.
+    std::vector<int> min, max;
+
+    frontier(const graph& g)
+    {
+      const int es_size = g.edges.size();
+
+      first_edge.resize(g.vertices, es_size);
+      last_edge.resize(g.vertices, -1);
+
+      for (int i = 0; i < es_size; ++i) {
+        for (const int x : { g.edges[i].first, g.edges[i].second }) {
+          first_edge[x] = std::min(first_edge[x], i);
+          last_edge[x]  = std::max(last_edge[x], i);
+        }
+      }
+
+      // The `i`th frontier starts at the smallest vertex with an edge at or
+      // after `i` and ends at the largest vertex with an edge at or before `i`.
+      min.resize(es_size + 1, g.vertices);
+      max.resize(es_size + 1, -1);
+
+      for (int x = 0; x < g.vertices; ++x) {
+        if (0 <= last_edge[x]) { min[last_edge[x]] = std::min(min[last_edge[x]], x); }
+        max[first_edge[x]] = std::max(max[first_edge[x]], x);
+      }
+      for (int i = es_size - 1; 0 <= i; --i) { min[i] = std::min(min[i], min[i + 1]); }
+      for (int i = 1; i <= es_size; ++i) { max[i] = std::max(max[i], max[i - 1]); }
+      for (int i = 0; i <= es_size; ++i) { max[i] = std::max(max[i], min[i] - 1); }
+    }
+
+    /// \brief Largest number of vertices in the frontier.
+    int
+    width() const
+    {
+      int res = 0;
+      for (size_t i = 0; i < min.size(); ++i) { res = std::max(res, max[i] - min[i] + 1); }
+      return res;
+    }
+  };
+
+  /// \brief Largest frontier that can be represented by the mate assignments.
+  constexpr int MAX_WIDTH = std::numeric_limits<char>::max();
+
+  /// \brief Construct the set of all Hamiltonian Cycles (or Paths).
+  template <typename Adapter>
+  typename Adapter::dd_t
+  create(Adapter& adapter, const graph& g)
+  {
+    // A single vertex is a (degenerate) cycle and path.
+    if (g.vertices == 1) { return adapter.top(); }
+
+    const std::vector<std::pair<int, int>>& es = g.edges;
+    const int es_size                          = es.size();
+
+    const frontier f(g);
+
+    // Vertices without any edges cannot be visited.
+    for (int x = 0; x < g.vertices; ++x) {
+      if (f.last_edge[x] < 0) { return adapter.bot(); }
+    }
+
+    // -------------------------------------------------------------------------
+    // Top-down: Enumerate all (distinct) frontier states for each edge and
+    // store the index of their children in the next level.
+    std::vector<std::vector<std::array<int64_t, 2>>> children(es_size);
+
+#ifdef BDD_BENCHMARK_STATS
+    size_t max_states = 0;
+    int max_frontier  = 0;
+#endif // BDD_BENCHMARK_STATS
+
+    std::vector<std::string> level_states;
+    {
+      // Initially, all vertices in the frontier are of degree 0.
+      std::string init(f.max[0] - f.min[0] + 1, 0);
+      for (size_t j = 0; j < init.size(); ++j) { init[j] = j; }
+      level_states.push_back(std::move(init));
+    }
+
+    for (int i = 0; i < es_size; ++i) {
+      const int lo      = f.min[i];
+      const int next_lo = f.min[i + 1];
+      const int next_hi = f.max[i + 1];
+
+      const int u = es[i].first - lo;
+      const int w = es[i].second - lo;
+
+      // Whether all vertices have been visited, assuming the remaining ones in
+      // the frontier are the end of the cycle (or path).
+      const auto complete = [&](const std::string& mate) -> bool {
+        if (f.max[i] != g.vertices - 1) { return false; }
+        for (const char m : mate) {
+          if (m != SATURATED) { return false; }
+        }
+        return true;
+      };
+
+      std::vector<std::string> next_states;
+      std::unordered_map<std::string, int64_t> next_idx;
+
+      // Move the frontier to the next edge and obtain the index of the state.
+      const auto next = [&](std::string mate) -> int64_t {
+        // Vertices that are not part of any later edge must be saturated or,
+        // for paths, be one of its two endpoints.
+        for (size_t j = 0; mate != DONE && j < mate.size(); ++j) {
+          if (f.last_edge[lo + j] != i || mate[j] == SATURATED) { continue; }
+          if (!count_paths || mate[j] == static_cast<char>(j)) { return FALSE; }
+
+          if (mate[j] == ANCHORED) {
+            mate[j] = SATURATED;
+            if (!complete(mate)) { return FALSE; }
+            mate = DONE;
+          } else {
+            // At most two endpoints may leave the frontier.
+            if (std::count(mate.begin(), mate.end(), ANCHORED) == 2) { return FALSE; }
+            mate[mate[j]] = ANCHORED;
+            mate[j]       = SATURATED;
+          }
+        }
+
+        if (i + 1 == es_size) { return mate == DONE ? TRUE : FALSE; }
+
+        std::string res;
+        if (mate != DONE) {
+          res.resize(next_hi - next_lo + 1);
+          for (int x = next_lo; x <= next_hi; ++x) {
+            const int j = x - lo;
+            if (j < static_cast<int>(mate.size())) {
+              res[x - next_lo] =
+                mate[j] == SATURATED || mate[j] == ANCHORED ? mate[j] : mate[j] + lo - next_lo;
+            } else {
+              res[x - next_lo] = x - next_lo;
+            }
+          }
+        }
+
+        const auto [it, inserted] = next_idx.try_emplace(res, next_states.size());
+        if (inserted) { next_states.push_back(std::move(res)); }
+        return it->second;
+      };
+
+      children[i].reserve(level_states.size());
+      for (const std::string& mate : level_states) {
+        // Edge is excluded.
+        const int64_t low = next(mate);
+
+        // Edge is included.
+        int64_t high = FALSE;
+        if (mate != DONE && mate[u] != SATURATED && mate[w] != SATURATED) {
+          const int a = mate[u];
+          const int b = mate[w];
+
+          std::string res = mate;
+          if (a == w || (a == ANCHORED && b == ANCHORED)) {
+            // Closing the path into a cycle (or connecting both endpoints of
+            // the path): all other vertices must already be saturated (and no
+            // vertices are left to be visited).
+            res[u] = SATURATED;
+            res[w] = SATURATED;
+            if (count_paths == (a == ANCHORED) && complete(res)) { high = next(DONE); }
+          } else {
+            // Join the two paths (each possibly just the vertex itself)
+            if (a != u) { res[u] = SATURATED; }
+            if (b != w) { res[w] = SATURATED; }
+            if (a != ANCHORED) { res[a] = b; }
+            if (b != ANCHORED) { res[b] = a; }
+
+            high = next(res);
+          }
+        }
+
+        children[i].push_back({ low, high });
+      }
+
+#ifdef BDD_BENCHMARK_STATS
+      max_states   = std::max(max_states, level_states.size());
+      max_frontier = std::max(max_frontier, f.max[i] - f.min[i] + 1);
+#endif // BDD_BENCHMARK_STATS
+
+      level_states = std::move(next_states);
+    }
+
+    // -------------------------------------------------------------------------
+    // Bottom-up: Construct the nodes of each edge.
+    std::vector<typename Adapter::build_node_t> next_nodes;
+    for (int i = es_size - 1; 0 <= i; --i) {
+      std::vector<typename Adapter::build_node_t> nodes;
+      nodes.reserve(children[i].size());
+
+      const auto node = [&](const int64_t child) {
+        if (child == FALSE) { return adapter.build_node(false); }
+        if (child == TRUE) { return adapter.build_node(true); }
+        return next_nodes[child];
+      };
+
+      for (const auto& [low, high] : children[i]) {
+        nodes.push_back(adapter.build_node(i, node(low), node(high)));
+#ifdef BDD_BENCHMARK_STATS
+        total_nodes += 1;
+#endif // BDD_BENCHMARK_STATS
+      }
+
+      next_nodes = std::move(nodes);
+      children[i].clear();
+      children[i].shrink_to_fit();
+    }
+
+    typename Adapter::dd_t paths = adapter.build();
+
+#ifdef BDD_BENCHMARK_STATS
+    largest_bdd = adapter.nodecount(paths);
+
+    std::cout << json::field("frontier (vertices)") << json::value(max_frontier) << json::comma
+              << json::endl;
+    std::cout << json::field("states (max)") << json::value(max_states) << json::endl;
+#endif // BDD_BENCHMARK_STATS
+
+    return paths;
+  }
+}
+
 constexpr size_t UNKNOWN = static_cast<size_t>(-1);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2465,23 +3131,27 @@ const size_t expected_knight[17] = {
 /// \brief   Expected number of closed Hamiltonian Grid Graph Tours.
 ///
 /// \details Most numbers are taken from https://oeis.org/A003763 . Otherwise,
-///          they are from our previous runs
+///          they are from our previous runs. Since most of them do not fit into
+///          64 bits, they are stored in their decimal representation.
 ////////////////////////////////////////////////////////////////////////////////
-const size_t expected_grid[13] = {
-  0,                   //  0x0  [_]
-  1,                   //  1x1  [_]
-  1,                   //  2x2  [3]
-  0,                   //  3x3  [3]
-  6,                   //  4x4  [3]
-  0,                   //  5x5  [3]
-  1072,                //  6x6  [3]
-  0,                   //  7x7  [3]
-  4638576,             //  8x8  [3]
-  0,                   //  9x9  [3]
-  467260456608,        // 10x10 [3]
-  0,                   // 11x11 [3]
-  1076226888605605706, // 12x12 [3]
-  // remaining numbers do not fit into 64 bits
+const char* const expected_grid[17] = {
+  "0",                                   //  0x0  [_]
+  "1",                                   //  1x1  [_]
+  "1",                                   //  2x2  [3]
+  "0",                                   //  3x3  [3]
+  "6",                                   //  4x4  [3]
+  "0",                                   //  5x5  [3]
+  "1072",                                //  6x6  [3]
+  "0",                                   //  7x7  [3]
+  "4638576",                             //  8x8  [3]
+  "0",                                   //  9x9  [3]
+  "467260456608",                        // 10x10 [3]
+  "0",                                   // 11x11 [3]
+  "1076226888605605706",                 // 12x12 [3]
+  "0",                                   // 13x13 [3]
+  "56126499620491437281263608",          // 14x14 [3]
+  "0",                                   // 15x15 [3]
+  "65882516522625836326159786165530572", // 16x16 [3]
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2504,6 +3174,36 @@ run_hamiltonian(int argc, char** argv)
     return 1;
   }
 
+  if ((!graph_path.empty() || count_paths) && enc != encoding::FRONTIER) {
+    std::cerr << "Graph files (-f) and paths (-p) are only supported by the 'frontier' encoding\n";
+    return -1;
+  }
+
+  // ---------------------------------------------------------------------------
+  // Initialise graph (i.e. variable ordering)
+  graph g;
+
+  if (enc == encoding::FRONTIER) {
+    if (graph_path.empty()) {
+      g = grid_graph();
+    } else {
+      std::optional<graph> parsed = parse_graph(graph_path);
+      if (!parsed) { return -1; }
+      g = reorder(*parsed, graph_order);
+    }
+
+    if (g.vertices == 0) {
+      std::cerr << "  | The graph has no vertices.\n";
+      return 1;
+    }
+
+    if (enc_frontier::MAX_WIDTH < enc_frontier::frontier(g).width()) {
+      std::cerr << "The frontier is too wide (more than " << enc_frontier::MAX_WIDTH
+                << " vertices)\n";
+      return -1;
+    }
+  }
+
   // ---------------------------------------------------------------------------
   // Initialise package manager
   int vars = 0;
@@ -2519,34 +3219,55 @@ run_hamiltonian(int argc, char** argv)
     vars = enc_time::vars();
     break;
   }
+  case encoding::FRONTIER: {
+    vars = enc_frontier::vars(g);
+    break;
+  }
   default: { /* ? */
   }
   }
 
   // -----------------------------------------------------------------------------
   // Initialise cells (i.e. variable ordering)
-  if (rows() < cols()) {
-    std::cerr << "Note:\n"
-              << "|   The variable ordering is designed for 'cols <= rows'.\n"
-              << "|   Maybe restart with the dimensions flipped?\n"
-              << "\n";
-  }
+  if (graph_path.empty()) {
+    if (rows() < cols()) {
+      std::cerr << "Note:\n"
+                << "|   The variable ordering is designed for 'cols <= rows'.\n"
+                << "|   Maybe restart with the dimensions flipped?\n"
+                << "\n";
+    }
 
-  init_cells_descending();
+    init_cells_descending();
+  }
 
   return run<Adapter>("hamiltonian", vars, [&](Adapter& adapter) {
     std::cout << json::field("encoding") << json::value(to_string(enc)) << json::comma
               << json::endl;
-    std::cout << json::field("rows") << json::value(rows()) << json::comma << json::endl;
-    std::cout << json::field("cols") << json::value(cols()) << json::comma << json::endl;
+    std::cout << json::field("problem") << json::value(count_paths ? "paths" : "cycles")
+              << json::comma << json::endl;
+    if (graph_path.empty()) {
+      std::cout << json::field("rows") << json::value(rows()) << json::comma << json::endl;
+      std::cout << json::field("cols") << json::value(cols()) << json::comma << json::endl;
+    } else {
+      std::cout << json::field("graph") << json::value(graph_path) << json::comma << json::endl;
+      std::cout << json::field("order") << json::value(to_string(graph_order)) << json::comma
+                << json::endl;
+      std::cout << json::field("vertices") << json::value(g.vertices) << json::comma
+                << json::endl;
+      std::cout << json::field("edges") << json::value(g.edges.size()) << json::comma
+                << json::endl;
+    }
     std::cout << json::endl;
 
-    uint64_t solutions;
+    big_uint solutions;
 
     // ---------------------------------------------------------------------------
     // Construct paths based on chosen encoding
-    std::cout << json::field(enc == encoding::TIME ? "apply" : "apply+exists") << json::brace_open
-              << json::endl;
+    const std::string paths_field = enc == encoding::TIME ? "apply"
+      : enc == encoding::FRONTIER                         ? "build"
+                                                          : "apply+exists";
+
+    std::cout << json::field(paths_field) << json::brace_open << json::endl;
 
 #ifdef BDD_BENCHMARK_STATS
     std::cout << json::field("intermediate results") << json::brace_open << json::endl;
@@ -2562,6 +3283,10 @@ run_hamiltonian(int argc, char** argv)
       paths = enc_gadgets::create(adapter, enc);
       break;
     }
+    case encoding::FRONTIER: {
+      paths = enc_frontier::create(adapter, g);
+      break;
+    }
     case encoding::TIME:
     default: {
       paths = enc_time::create(adapter);
@@ -2587,16 +3312,26 @@ run_hamiltonian(int argc, char** argv)
     // Count number of solutions
     std::cout << json::field("satcount") << json::brace_open << json::endl << json::flush;
 
-    const size_t vc =
-      enc == encoding::TIME ? enc_time::satcount_vars() : enc_gadgets::satcount_vars(enc);
+    const size_t vc = enc == encoding::TIME ? enc_time::satcount_vars()
+      : enc == encoding::FRONTIER           ? enc_frontier::satcount_vars(g)
+                                            : enc_gadgets::satcount_vars(enc);
 
     const time_point before_satcount = now();
-    solutions                        = adapter.satcount(paths, vc);
+    solutions                        = adapter.satcount_exact(paths, vc);
     const time_point after_satcount  = now();
 
     const time_duration satcount_time = duration_ms(before_satcount, after_satcount);
 
     std::cout << json::field("result") << json::value(solutions) << json::comma << json::endl;
+    std::cout << json::field("approximate") << json::value(!Adapter::exact_satcount)
+              << json::comma << json::endl;
+    std::cout << json::field("result (log2)");
+    if (solutions.is_zero()) {
+      std::cout << json::nil;
+    } else {
+      std::cout << json::value(solutions.log2());
+    }
+    std::cout << json::comma << json::endl;
     std::cout << json::field("time (ms)") << json::value(satcount_time) << json::endl;
     std::cout << json::brace_close << json::comma << json::endl << json::flush;
 
@@ -2619,8 +3354,9 @@ run_hamiltonian(int argc, char** argv)
               << json::value(init_time + paths_time + satcount_time) << json::endl
               << json::flush;
 
-    if (rows() == cols() && rows() < size(expected_grid) && expected_grid[rows()] != UNKNOWN
-        && solutions != expected_grid[rows()]) {
+    // Without an exact model count, the result may be rounded or have overflowed.
+    if (Adapter::exact_satcount && graph_path.empty() && !count_paths && rows() == cols()
+        && rows() < size(expected_grid) && solutions.to_string() != expected_grid[rows()]) {
       return -1;
     }
     return 0;
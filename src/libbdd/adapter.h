@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "../common/adapter.h"
+#include "../common/satcount.h"
 
 #include "lib-bdd.h"
 
@@ -452,6 +453,11 @@ public:
 
   static constexpr bool complement_edges = false;
 
+  static constexpr bool thread_safe      = false;
+  static constexpr bool supports_rename  = true;
+  static constexpr bool supports_relnext = true;
+  static constexpr bool exact_satcount   = false;
+
   using dd_t         = lib_bdd::bdd_function;
   using build_node_t = lib_bdd::bdd_function;
 
@@ -669,6 +675,19 @@ public:
       .and_exists(rel, _relprev_vars.data(), _relprev_vars.size());
   }
 
+  inline lib_bdd::bdd_function
+  rename(const lib_bdd::bdd_function& f, const std::function<int(int)>& m)
+  {
+    assert(is_variable_permutation(_varcount, m));
+
+    std::vector<lib_bdd::var_pair> renaming;
+    for (uint16_t x = 0; x < _varcount; ++x) {
+      if (m(x) != x) { renaming.push_back(lib_bdd::var_pair{ x, static_cast<uint16_t>(m(x)) }); }
+    }
+
+    return f.rename_variables(renaming.data(), renaming.size());
+  }
+
   inline uint64_t
   nodecount(const lib_bdd::bdd_function& f)
   {
@@ -691,6 +710,21 @@ public:
     return f.sat_count() / std::pow(2, excess_variables);
   }
 
+  inline big_uint
+  satcount_exact(const lib_bdd::bdd_function& f)
+  {
+    return this->satcount_exact(f, this->_varcount);
+  }
+
+  inline big_uint
+  satcount_exact(const lib_bdd::bdd_function& f, const size_t vc)
+  {
+    assert(vc <= this->_varcount);
+
+    // The C API of lib-bdd does not export its nodes; the count is only as precise as a double.
+    return big_uint::from_double(f.sat_count(), static_cast<int>(vc) - this->_varcount);
+  }
+
   inline lib_bdd::bdd_function
   satone(const lib_bdd::bdd_function& f)
   {
@@ -13,7 +13,7 @@ run_relprod<libbdd_bdd_adapter>(int argc, char** argv)
   const bool should_exit = parse_input<parsing_policy>(argc, argv);
   if (should_exit) { return -1; }
 
-  if (relation_path == "") {
+  if (relation_paths.empty()) {
     std::cerr << "Path for relation missing\n";
     return -1;
   }
@@ -25,10 +25,25 @@ run_relprod<libbdd_bdd_adapter>(int argc, char** argv)
   // =============================================================================================
   // Load 'lib-bdd' files
   int varcount = 0;
-  {
-    const lib_bdd::bdd libbdd_relation = lib_bdd::deserialize(relation_path);
-    varcount = lib_bdd::stats(libbdd_relation).levels;
+
+  std::vector<lib_bdd::bdd> libbdd_relations;
+  for (const std::string& path : relation_paths) {
+    libbdd_relations.push_back(lib_bdd::deserialize(path));
+    varcount = std::max<int>(varcount, lib_bdd::stats(libbdd_relations.back()).levels);
+  }
+  const lib_bdd::bdd libbdd_states = lib_bdd::deserialize(states_path);
+
+  // Variables are not remapped, when loaded directly into LibBDD.
+  lib_bdd::var_map vm;
+  for (int x = 0; x < varcount; ++x) { vm.insert({ x, x }); }
+
+  std::vector<support_t> relation_supports;
+  for (const lib_bdd::bdd& f : libbdd_relations) {
+    relation_supports.push_back(support_of(f, vm, varcount));
   }
+  libbdd_relations.clear();
+
+  const support_t states_support = support_of(libbdd_states, vm, varcount);
 
   // =============================================================================================
   // Initialize BDD package
@@ -37,28 +52,46 @@ run_relprod<libbdd_bdd_adapter>(int argc, char** argv)
 
     // =============================================================================================
     // Reconstruct DDs
-    libbdd_bdd_adapter::dd_t relation = adapter.bot();
-    {
+    std::vector<libbdd_bdd_adapter::dd_t> relations;
+
+    if (relation_paths.size() == 1) {
       std::cout << json::field("relation") << json::brace_open << json::endl;
+    } else {
+      std::cout << json::field("relations") << json::array_open << json::endl;
+    }
 
-      std::cout << json::field("path") << json::value(relation_path) << json::comma
+    for (size_t i = 0; i < relation_paths.size(); ++i) {
+      if (1 < relation_paths.size()) {
+        std::cout << json::indent << json::brace_open << json::endl;
+      }
+
+      std::cout << json::field("path") << json::value(relation_paths[i]) << json::comma
                 << json::endl;
 
       const time_point t_rebuild_before = now();
-      relation = adapter.load(relation_path);
+      relations.push_back(adapter.load(relation_paths[i]));
       const time_point t_rebuild_after = now();
 
       const size_t rebuild_time = duration_ms(t_rebuild_before, t_rebuild_after);
       total_time += rebuild_time;
 
-      std::cout << json::field("size (nodes)") << json::value(adapter.nodecount(relation))
+      std::cout << json::field("size (nodes)") << json::value(adapter.nodecount(relations.back()))
                 << json::comma << json::endl;
-      std::cout << json::field("satcount") << json::value(adapter.satcount(relation))
+      std::cout << json::field("satcount") << json::value(adapter.satcount(relations.back()))
                 << json::comma << json::endl;
       std::cout << json::field("time (ms)")
                 << json::value(rebuild_time) << json::endl;
 
+      if (1 < relation_paths.size()) {
+        std::cout << json::brace_close << (i + 1 < relation_paths.size() ? "," : "")
+                  << json::endl;
+      }
+    }
+
+    if (relation_paths.size() == 1) {
       std::cout << json::brace_close << json::comma << json::endl;
+    } else {
+      std::cout << json::array_close << json::comma << json::endl;
     }
 
     libbdd_bdd_adapter::dd_t states = adapter.bot();
@@ -112,25 +145,16 @@ run_relprod<libbdd_bdd_adapter>(int argc, char** argv)
 
     // =============================================================================================
     // Relational Product
-    libbdd_bdd_adapter::dd_t result = adapter.bot();
-
     std::cout << json::field("relprod") << json::brace_open << json::endl << json::flush;
 
-    const time_point t_relprod_before = now();
-    switch (oper) {
-    case operand::NEXT: result = adapter.relnext(states, relation, support); break;
-    case operand::PREV: result = adapter.relprev(states, relation, support); break;
-    }
-    const time_point t_relprod_after = now();
-
-    const size_t relprod_time = duration_ms(t_relprod_before, t_relprod_after);
+    const auto [result, relprod_time] =
+      relprod(adapter, states, states_support, relations, relation_supports, support, varcount);
     total_time += relprod_time;
 
-    std::cout << json::field("operand") << json::value(to_string(oper)) << json::comma
-              << json::endl;
     std::cout << json::field("size (nodes)") << adapter.nodecount(result) << json::comma
               << json::endl;
-    std::cout << json::field("satcount") << adapter.satcount(result, varcount) << json::comma << json::endl;
+    std::cout << json::field("satcount") << adapter.satcount(result, varcount / 2) << json::comma
+              << json::endl;
     std::cout << json::field("time (ms)") << relprod_time << json::endl;
 
     std::cout << json::brace_close << json::comma << json::endl;
@@ -35,16 +35,10 @@
 
 // Common
 #include "common/adapter.h"
+#include "common/bandwidth.h"
 #include "common/chrono.h"
 #include "common/input.h"
 
-// Boost
-#include <boost/config.hpp>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/properties.hpp>
-#include <boost/graph/cuthill_mckee_ordering.hpp>
-#include <boost/graph/sloan_ordering.hpp>
-
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // PARAMETER PARSING
@@ -1698,23 +1692,14 @@ public:
   }
 
 private:
-  using boost__vertex_properties = boost::property<
-    boost::vertex_color_t,
-    boost::default_color_type,
-    boost::property<boost::vertex_degree_t, int, boost::property<boost::vertex_priority_t, int>>>;
-
-  using boost__graph_type =
-    boost::adjacency_list<boost::setS, boost::vecS, boost::undirectedS, boost__vertex_properties>;
-
-  using boost__vertex_type = boost::graph_traits<boost__graph_type>::vertex_descriptor;
-  using boost__size_type   = boost::graph_traits<boost__graph_type>::vertices_size_type;
+  using edge_list = std::vector<std::pair<int, int>>;
 
   /// \brief Creates the incidence graph, i.e. a graph where variables are nodes and are connected
   ///        if they occur in the same transition together.
-  static inline boost__graph_type
-  boost__incidence_graph(const transition_system& ts)
+  static inline edge_list
+  incidence_graph(const transition_system& ts)
   {
-    boost__graph_type g(ts.vars().size());
+    edge_list g;
 
     // Add an edge to the graph, for variables that occur in the same transition.
     for (const transition_system::transition& t : ts.transitions()) {
@@ -1729,11 +1714,11 @@ private:
       for (const int x : x_support) {
         for (const int y : pre_support) {
           if (x == y) { continue; }
-          boost::add_edge(x, y, g);
+          g.push_back({ x, y });
         }
         for (const int y : post_support) {
           if (x == y) { continue; }
-          boost::add_edge(x, y, g);
+          g.push_back({ x, y });
         }
       }
     }
@@ -1741,10 +1726,9 @@ private:
     return g;
   }
 
-  /// \brief Converts an ordering from a `boost__incidence_graph(ts)` into a variable permutation.
+  /// \brief Converts an ordering of the `incidence_graph(ts)` into a variable permutation.
   static inline variable_permutation
-  boost__incidence_permutation(const transition_system& /*ts*/,
-                               const std::vector<boost__vertex_type>& o)
+  incidence_permutation(const transition_system& /*ts*/, const std::vector<int>& o)
   {
     std::unordered_map<int, int> out;
     for (auto it = o.begin(); it != o.end(); ++it) { out.insert({ *it, out.size() }); }
@@ -1757,35 +1741,34 @@ private:
   /// \details See "Bandwidth and Wavefront Reduction for Static Variable Ordering in Symbolic Model
   ///          Checking" by Jeroen Meijer and Jaco van de Pol.
   template <bool IncludeRead, bool IncludeWrite>
-  static inline boost__graph_type
-  boost__rw_graph(const transition_system& ts)
+  static inline edge_list
+  rw_graph(const transition_system& ts)
   {
-    const boost__vertex_type var_count        = ts.vars().size();
-    const boost__vertex_type transition_count = ts.transitions().size();
+    const int transition_count = ts.transitions().size();
 
-    boost__graph_type g(var_count + transition_count);
+    edge_list g;
 
-    for (size_t t_idx = 0; t_idx < transition_count; ++t_idx) {
+    for (int t_idx = 0; t_idx < transition_count; ++t_idx) {
       const transition_system::transition& t = ts.transitions().at(t_idx);
 
       if constexpr (IncludeRead) {
         const std::set<int> pre_support = t.pre().support();
-        for (const int x : pre_support) { boost::add_edge(t_idx, transition_count + x, g); }
+        for (const int x : pre_support) { g.push_back({ t_idx, transition_count + x }); }
       }
       if constexpr (IncludeWrite) {
         const std::set<int> post_support = t.post().support();
-        for (const int x : post_support) { boost::add_edge(t_idx, transition_count + x, g); }
+        for (const int x : post_support) { g.push_back({ t_idx, transition_count + x }); }
       }
     }
 
     return g;
   }
 
-  /// \brief Converts an ordering from a `boost__write_graph(ts)` into a variable permutation.
+  /// \brief Converts an ordering of the `rw_graph(ts)` into a variable permutation.
   static inline variable_permutation
-  boost__rw_permutation(const transition_system& ts, const std::vector<boost__vertex_type>& o)
+  rw_permutation(const transition_system& ts, const std::vector<int>& o)
   {
-    const boost__vertex_type transition_count = ts.transitions().size();
+    const int transition_count = ts.transitions().size();
 
     std::unordered_map<int, int> out;
     for (auto it = o.begin(); it != o.end(); ++it) {
@@ -1802,18 +1785,9 @@ public:
   static variable_permutation
   cuthill_mckee(const transition_system& ts)
   {
-    auto g              = boost__incidence_graph(ts);
-    const auto g_color  = boost::get(boost::vertex_color, g);
-    const auto g_degree = boost::make_degree_map(g);
-
-    // From Boost Documentation on "Sloan's Ordering":
-    //   "Usually you need the reversed ordering with the Cuthill-McKee algorithm (...)"
-    //
-    // From our preliminary experiments, the opposite is the case for BDDs.
-    std::vector<boost__vertex_type> boost_order(boost::num_vertices(g), -1);
-    boost::cuthill_mckee_ordering(g, boost_order.begin(), g_color, g_degree);
-
-    return boost__incidence_permutation(ts, boost_order);
+    const std::vector<int> order =
+      bandwidth_ordering(ts.vars().size(), incidence_graph(ts), bandwidth_order::CUTHILL_MCKEE);
+    return incidence_permutation(ts, order);
   }
 
   //////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1857,36 +1831,9 @@ public:
   static variable_permutation
   sloan(const transition_system& ts)
   {
-    auto g                = boost__incidence_graph(ts);
-    const auto g_color    = boost::get(boost::vertex_color, g);
-    const auto g_degree   = boost::make_degree_map(g);
-    const auto g_priority = boost::get(boost::vertex_priority, g);
-
-    // From Boost Documentation on "Sloan's Ordering":
-    //   "(...) and the direct ordering with the Sloan algorithm."
-    //
-    // From our preliminary experiments, the opposite is the case for BDDs.
-    std::vector<boost__vertex_type> boost_order(boost::num_vertices(g), -1);
-
-    // Cuthill-McKee ensures all components are numbered. Yet, Sloan's algorithm seems to only
-    // provide a relabelling of the single component where the start (end?) vertex is.
-    std::unordered_set<boost__vertex_type> boost_uncovered;
-    for (boost__vertex_type x = 0; x < boost::num_vertices(g); ++x) { boost_uncovered.insert(x); }
-
-    auto rbegin = boost_order.rbegin();
-    while (!boost_uncovered.empty()) {
-      assert(boost_uncovered.size() > 0);
-      const boost__vertex_type x = *boost_uncovered.begin();
-      const auto next_rbegin =
-        boost::sloan_ordering(g, x, x, rbegin, g_color, g_degree, g_priority);
-
-      for (auto x_iter = rbegin; x_iter != next_rbegin; ++x_iter) {
-        boost_uncovered.erase(*x_iter);
-      }
-      rbegin = next_rbegin;
-    }
-
-    return boost__incidence_permutation(ts, boost_order);
+    const std::vector<int> order =
+      bandwidth_ordering(ts.vars().size(), incidence_graph(ts), bandwidth_order::SLOAN);
+    return incidence_permutation(ts, order);
   }
 
 public:
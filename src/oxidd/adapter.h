@@ -1,3 +1,4 @@
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -5,9 +6,11 @@
 #include <ranges>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #include "../common/adapter.h"
+#include "../common/satcount.h"
 
 #include "oxidd/bdd.hpp"
 #include "oxidd/bcdd.hpp"
@@ -35,6 +38,46 @@ compute_init_size(unsigned cache_arity)
   return { std::min(x, ((size_t)1 << 32) - 2), y };
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Fork-join of two tasks on the worker pool of an OxiDD manager.
+///
+/// \details The forked task is handed to the manager's worker pool while the calling worker
+///          evaluates the other task. At most `threads - 1` tasks are forked at a time; beyond
+///          that, both tasks are evaluated by the calling worker. Since a forking worker waits for
+///          its forked task, this bound leaves at least one worker free to make progress.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class oxidd_fork_join
+{
+private:
+  std::atomic<int> _forkable;
+
+public:
+  oxidd_fork_join()
+    : _forkable(threads - 1)
+  {}
+
+  template <typename Manager>
+  void
+  par(Manager& manager, const std::function<int()>& f, const std::function<int()>& g)
+  {
+    // Reserve a worker for `f`, if any is left.
+    int forkable = _forkable.load();
+    while (0 < forkable && !_forkable.compare_exchange_weak(forkable, forkable - 1)) {}
+
+    if (forkable <= 0) {
+      f();
+      g();
+      return;
+    }
+
+    std::thread t([&manager, &f]() { manager.run_in_worker_pool(f); });
+    g();
+    t.join();
+
+    _forkable.fetch_add(1);
+  }
+};
+
 class oxidd_bdd_adapter
 {
 public:
@@ -46,11 +89,17 @@ public:
 
   static constexpr bool complement_edges = false;
 
+  static constexpr bool thread_safe      = true;
+  static constexpr bool supports_rename  = true;
+  static constexpr bool supports_relnext = true;
+  static constexpr bool exact_satcount   = false;
+
   using dd_t         = oxidd::bdd_function;
   using build_node_t = oxidd::bdd_function;
 
 private:
   oxidd::bdd_manager _manager;
+  oxidd_fork_join _tasks;
   oxidd::bdd_function _latest_build;
 
   oxidd::bdd_substitution _relnext_pairs;
@@ -77,6 +126,14 @@ public:
     return res;
   }
 
+  /// Evaluate `f` and `g` in parallel, where `f` is forked onto another worker of the manager's
+  /// worker pool (if one is available)
+  inline void
+  par(const std::function<int()>& f, const std::function<int()>& g)
+  {
+    _tasks.par(_manager, f, g);
+  }
+
   // BDD Operations
 public:
   inline oxidd::bdd_function
@@ -254,6 +311,21 @@ public:
       .apply_exists(oxidd::util::boolean_operator::AND, rel, _relprev_vars);
   }
 
+  inline oxidd::bdd_function
+  rename(const oxidd::bdd_function& f, const std::function<int(int)>& m)
+  {
+    const oxidd::var_no_t num_vars = _manager.num_vars();
+    assert(is_variable_permutation(num_vars, m));
+
+    std::vector<std::pair<oxidd::var_no_t, oxidd::bdd_function>> pairs;
+    for (oxidd::var_no_t x = 0; x < num_vars; ++x) {
+      const oxidd::var_no_t y = m(x);
+      if (y != x) { pairs.push_back({ x, _manager.var(y) }); }
+    }
+
+    return f.substitute(oxidd::bdd_substitution(pairs));
+  }
+
   inline uint64_t
   nodecount(const oxidd::bdd_function& f)
   {
@@ -273,6 +345,21 @@ public:
     return f.sat_count_double(vc);
   }
 
+  inline big_uint
+  satcount_exact(const oxidd::bdd_function& f)
+  {
+    return this->satcount_exact(f, _manager.num_vars());
+  }
+
+  inline big_uint
+  satcount_exact(const oxidd::bdd_function& f, const size_t vc)
+  {
+    assert(vc <= _manager.num_vars());
+
+    // OxiDD's C++ API only provides the count as a double.
+    return big_uint::from_double(f.sat_count_double(vc));
+  }
+
   inline oxidd::bdd_function
   satone(const oxidd::bdd_function& f)
   {
@@ -366,11 +453,17 @@ public:
 
   static constexpr bool complement_edges = true;
 
+  static constexpr bool thread_safe      = true;
+  static constexpr bool supports_rename  = true;
+  static constexpr bool supports_relnext = true;
+  static constexpr bool exact_satcount   = false;
+
   using dd_t         = oxidd::bcdd_function;
   using build_node_t = oxidd::bcdd_function;
 
 private:
   oxidd::bcdd_manager _manager;
+  oxidd_fork_join _tasks;
   oxidd::bcdd_function _latest_build;
 
   oxidd::bcdd_substitution _relnext_pairs;
@@ -396,6 +489,14 @@ public:
     return _manager.run_in_worker_pool(std::move(f));
   }
 
+  /// Evaluate `f` and `g` in parallel, where `f` is forked onto another worker of the manager's
+  /// worker pool (if one is available)
+  inline void
+  par(const std::function<int()>& f, const std::function<int()>& g)
+  {
+    _tasks.par(_manager, f, g);
+  }
+
   // BDD Operations
 public:
   inline oxidd::bcdd_function
@@ -573,6 +674,21 @@ public:
       .apply_exists(oxidd::util::boolean_operator::AND, rel, _relprev_vars);
   }
 
+  inline oxidd::bcdd_function
+  rename(const oxidd::bcdd_function& f, const std::function<int(int)>& m)
+  {
+    const oxidd::var_no_t num_vars = _manager.num_vars();
+    assert(is_variable_permutation(num_vars, m));
+
+    std::vector<std::pair<oxidd::var_no_t, oxidd::bcdd_function>> pairs;
+    for (oxidd::var_no_t x = 0; x < num_vars; ++x) {
+      const oxidd::var_no_t y = m(x);
+      if (y != x) { pairs.push_back({ x, _manager.var(y) }); }
+    }
+
+    return f.substitute(oxidd::bcdd_substitution(pairs));
+  }
+
   inline uint64_t
   nodecount(const oxidd::bcdd_function& f)
   {
@@ -592,6 +708,21 @@ public:
     return f.sat_count_double(vc);
   }
 
+  inline big_uint
+  satcount_exact(const oxidd::bcdd_function& f)
+  {
+    return this->satcount_exact(f, _manager.num_vars());
+  }
+
+  inline big_uint
+  satcount_exact(const oxidd::bcdd_function& f, const size_t vc)
+  {
+    assert(vc <= _manager.num_vars());
+
+    // OxiDD's C++ API only provides the count as a double.
+    return big_uint::from_double(f.sat_count_double(vc));
+  }
+
   inline oxidd::bcdd_function
   satone(const oxidd::bcdd_function& f)
   {
@@ -687,12 +818,18 @@ public:
 
   static constexpr bool complement_edges = false;
 
+  static constexpr bool thread_safe      = true;
+  static constexpr bool supports_rename  = false;
+  static constexpr bool supports_relnext = false;
+  static constexpr bool exact_satcount   = false;
+
 public:
   using dd_t         = oxidd::zbdd_function;
   using build_node_t = oxidd::zbdd_function;
 
 private:
   oxidd::zbdd_manager _manager;
+  oxidd_fork_join _tasks;
   oxidd::zbdd_function _latest_build;
 
   // Init and Deinit
@@ -709,6 +846,14 @@ public:
     return _manager.run_in_worker_pool(std::move(f));
   }
 
+  /// Evaluate `f` and `g` in parallel, where `f` is forked onto another worker of the manager's
+  /// worker pool (if one is available)
+  inline void
+  par(const std::function<int()>& f, const std::function<int()>& g)
+  {
+    _tasks.par(_manager, f, g);
+  }
+
   // ZDD Operations
 public:
   inline oxidd::zbdd_function
@@ -849,6 +994,21 @@ public:
     return f.sat_count_double(vc);
   }
 
+  inline big_uint
+  satcount_exact(const oxidd::zbdd_function& f)
+  {
+    return this->satcount_exact(f, _manager.num_vars());
+  }
+
+  inline big_uint
+  satcount_exact(const oxidd::zbdd_function& f, const size_t vc)
+  {
+    assert(vc <= _manager.num_vars());
+
+    // OxiDD's C++ API only provides the count as a double.
+    return big_uint::from_double(f.sat_count_double(vc));
+  }
+
   inline std::vector<std::pair<uint32_t, char>>
   pickcube(const oxidd::zbdd_function& f)
   {
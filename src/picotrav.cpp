@@ -2,9 +2,13 @@
 #include <cassert>
 
 // Data Structures
+#include <array>
+#include <limits>
 #include <optional>
+#include <queue>
 #include <unordered_map>
 #include <string>
+#include <tuple>
 #include <vector>
 
 // Randomisation
@@ -14,11 +18,18 @@
 #include <blifparse.hpp>
 #include <filesystem>
 
+// Reading AIGER files
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
 // sorting, shuffling
 #include <algorithm>
+#include <numeric>
 
 #include "common/adapter.h"
 #include "common/chrono.h"
+#include "common/force.h"
 #include "common/input.h"
 
 // ========================================================================== //
@@ -37,6 +48,10 @@ enum class variable_order
   LEVEL,
   LEVEL_DF,
   FUJITA,
+  FORCE,
+  FORCE_DF,
+  SIFT,
+  FORCE_SIFT,
   RANDOM,
   ZIP
 };
@@ -54,30 +69,87 @@ to_string(const variable_order o)
   case variable_order::LEVEL:          return "level";
   case variable_order::LEVEL_DF:       return "level_df";
   case variable_order::FUJITA:         return "fujita";
+  case variable_order::FORCE:          return "force";
+  case variable_order::FORCE_DF:       return "force_df";
+  case variable_order::SIFT:           return "sift";
+  case variable_order::FORCE_SIFT:     return "force_sift";
   case variable_order::RANDOM:         return "random";
   case variable_order::ZIP:            return "zip";
   }
   return "?";
 }
 
-variable_order var_order = variable_order::INPUT;
-bool match_io_names      = false;
+enum class gate_schedule
+{
+  DF,
+  LEVEL,
+  MIN_LIVE,
+  MIN_NODES
+};
+
+std::string
+to_string(const gate_schedule s)
+{
+  switch (s) {
+  case gate_schedule::DF:        return "depth-first";
+  case gate_schedule::LEVEL:     return "level";
+  case gate_schedule::MIN_LIVE:  return "min-live";
+  case gate_schedule::MIN_NODES: return "min-nodes";
+  }
+  return "?";
+}
+
+enum class equivalence_check
+{
+  FULL,
+  SWEEP
+};
+
+std::string
+to_string(const equivalence_check c)
+{
+  switch (c) {
+  case equivalence_check::FULL:  return "full";
+  case equivalence_check::SWEEP: return "sweep";
+  }
+  return "?";
+}
+
+variable_order var_order      = variable_order::INPUT;
+gate_schedule schedule        = gate_schedule::DF;
+equivalence_check equiv_check = equivalence_check::SWEEP;
+bool match_io_names           = false;
 
 class parsing_policy
 {
 public:
   static constexpr std::string_view name = "Picotrav";
-  static constexpr std::string_view args = "f:o:m:";
+  static constexpr std::string_view args = "c:f:o:m:s:";
 
   static constexpr std::string_view help_text =
-    "        -f PATH               Path to '.blif' file(s)\n"
+    "        -c CHECK     [sweep]  Equivalence checking of two circuits\n"
+    "        -f PATH               Path to '.blif' or AIGER file(s)\n"
     "        -m MATCH     [order]  Matching of circuit inputs and outputs\n"
-    "        -o ORDER     [input]  Variable order to derive from first circuit";
+    "        -o ORDER     [input]  Variable order to derive from first circuit\n"
+    "        -s SCHEDULE  [df]     Order in which gates are evaluated";
 
   static inline bool
   parse_input(const int c, const char* arg)
   {
     switch (c) {
+    case 'c': {
+      const std::string lower_arg = ascii_tolower(arg);
+
+      if (is_prefix(lower_arg, "sweep")) {
+        equiv_check = equivalence_check::SWEEP;
+      } else if (is_prefix(lower_arg, "full")) {
+        equiv_check = equivalence_check::FULL;
+      } else {
+        std::cerr << "Undefined equivalence check: " << arg << "\n";
+        return true;
+      }
+      return false;
+    }
     case 'f': {
       if (!std::filesystem::exists(arg)) {
         std::cerr << "File '" << arg << "' does not exist\n";
@@ -127,6 +199,14 @@ public:
         var_order = variable_order::LEVEL_DF;
       } else if (is_prefix(lower_arg, "fujita")) {
         var_order = variable_order::FUJITA;
+      } else if (is_prefix(lower_arg, "force")) {
+        var_order = variable_order::FORCE;
+      } else if (is_prefix(lower_arg, "force_depth-first") || lower_arg == "force_df") {
+        var_order = variable_order::FORCE_DF;
+      } else if (is_prefix(lower_arg, "sift")) {
+        var_order = variable_order::SIFT;
+      } else if (is_prefix(lower_arg, "force_sift")) {
+        var_order = variable_order::FORCE_SIFT;
       } else if (is_prefix(lower_arg, "random")) {
         var_order = variable_order::RANDOM;
       } else if (is_prefix(lower_arg, "zip")) {
@@ -137,6 +217,23 @@ public:
       }
       return false;
     }
+    case 's': {
+      const std::string lower_arg = ascii_tolower(arg);
+
+      if (is_prefix(lower_arg, "depth-first") || lower_arg == "df") {
+        schedule = gate_schedule::DF;
+      } else if (is_prefix(lower_arg, "level")) {
+        schedule = gate_schedule::LEVEL;
+      } else if (is_prefix(lower_arg, "min-live") || is_prefix(lower_arg, "live")) {
+        schedule = gate_schedule::MIN_LIVE;
+      } else if (is_prefix(lower_arg, "min-nodes") || is_prefix(lower_arg, "nodes")) {
+        schedule = gate_schedule::MIN_NODES;
+      } else {
+        std::cerr << "Undefined schedule: " << arg << "\n";
+        return true;
+      }
+      return false;
+    }
     default: return true;
     }
   }
@@ -171,6 +268,8 @@ public:
   bool is_input = false;
   /// True iff this is an output node
   bool is_output = false;
+  /// True iff this is the next-state function of a latch
+  bool is_next_state = false;
 
   /// Input (dependant) nets
   std::vector<node_id_t> deps                    = {};
@@ -181,6 +280,17 @@ public:
   unsigned ref_count = 0;
 };
 
+/// A latch, i.e. a state variable. Its current value is an input node to the net.
+struct latch_t
+{
+  /// The (input) node with the latch's current value
+  node_id_t current;
+  /// The node with the latch's next value
+  node_id_t next;
+  /// The latch's initial value (DONT_CARE if it is uninitialised)
+  logic_value init = logic_value::DONT_CARE;
+};
+
 struct net_t
 {
 public:
@@ -188,6 +298,7 @@ public:
 
   std::unordered_map<node_id_t, unsigned> inputs_w_order = {};
   std::vector<node_id_t> outputs_in_order                = {};
+  std::vector<latch_t> latches                           = {};
   /// Node store shared across nets
   ///
   /// Enables us to compute variable orders on the "union" net
@@ -209,6 +320,26 @@ public:
     return { id, inserted };
   }
 
+  /// Add `node` to the net without making it accessible by its name
+  ///
+  /// Returns the node's id.
+  node_id_t
+  add_anonymous_node(node_t node)
+  {
+    nodes.emplace_back(std::move(node));
+    return nodes.size() - 1;
+  }
+
+  /// The outputs followed by the next-state functions of all latches, i.e. all nodes needed.
+  std::vector<node_id_t>
+  roots() const
+  {
+    std::vector<node_id_t> res(outputs_in_order);
+    res.reserve(outputs_in_order.size() + latches.size());
+    for (const latch_t& l : latches) { res.push_back(l.next); }
+    return res;
+  }
+
   /// Checks if all reachable nodes are defined and the net is acyclic
   ///
   /// Also computes the nodes' depths and reference counts. This method must not be called more than
@@ -218,66 +349,70 @@ public:
   bool
   validate()
   {
-    // If a cycle was found, this contains its nodes in reversed order
-    std::vector<node_id_t> cycle;
+    // Depth-first traversal with an explicit stack of (node, next dependency) pairs, since circuits
+    // may be far deeper than what recursion on the call stack allows.
+    std::vector<std::pair<node_id_t, size_t>> stack;
+
+    for (const node_id_t output : roots()) {
+      if (!validate_visit(output, stack)) { return false; }
+
+      while (!stack.empty()) {
+        const node_id_t id = stack.back().first;
+        const node_t& node = nodes[id];
 
-    for (const node_id_t output : outputs_in_order) {
-      if (!validate_rec(output, cycle)) { return false; }
+        if (stack.back().second < node.deps.size()) {
+          const node_id_t dep = node.deps[stack.back().second++];
+          if (!validate_visit(dep, stack)) { return false; }
+          continue;
+        }
+
+        unsigned depth = 0;
+        for (const node_id_t dep : node.deps) { depth = std::max(depth, nodes[dep].depth + 1); }
+
+        // Important: only set `node.depth` after all children have been visited for the cycle
+        // detection.
+        nodes[id].depth = depth;
+        stack.pop_back();
+      }
     }
     return true;
   }
 
 private:
-  /// Returns the node's depth or none if the validation failed
-  std::optional<unsigned>
-  validate_rec(const node_id_t id, std::vector<node_id_t>& cycle)
+  /// Visit the node `id` from its parent (if any) at the top of the `stack`. Unvisited nodes are
+  /// pushed onto the `stack`.
+  ///
+  /// Returns false iff the validation failed
+  bool
+  validate_visit(const node_id_t id, std::vector<std::pair<node_id_t, size_t>>& stack)
   {
     node_t& node = nodes[id];
     if (node.ref_count++ != 0) {
       // The node has already been visited. We use the depth field to detect cycles: We only set the
       // depth once all children have been visited. So if the depth is still 0 and the node has
-      // children, the node is part of a cycle.
+      // children, the node is part of a cycle, i.e. it is somewhere on the stack.
       if (node.depth == 0 && !node.deps.empty()) {
         std::cerr << "Cycle detected: " << node.name;
-        cycle.push_back(id);
-        return {};
+
+        auto it = std::find_if(stack.begin(), stack.end(), [id](const auto& e) {
+          return e.first == id;
+        });
+        assert(it != stack.end());
+
+        for (++it; it != stack.end(); ++it) { std::cerr << " -> " << nodes[it->first].name; }
+        std::cerr << " -> " << node.name << "\n";
+        return false;
       }
-      return node.depth;
+      return true;
     }
 
     if (!node.is_defined) {
       std::cerr << "Referenced net '" << node.name << "' is undefined." << std::endl;
-      return {};
-    }
-
-    unsigned depth = 0;
-    for (const node_id_t dep : node.deps) {
-      const std::optional<unsigned> dep_depth = validate_rec(dep, cycle);
-
-      if (!dep_depth) { // error
-        if (!cycle.empty()) {
-          // A cycle was detected, we capture all the nodes until the first node of the cycle we
-          // visited while returning. Then we print the cycle.
-          if (cycle[0] != id) {
-            cycle.push_back(id);
-          } else {
-            for (auto it = cycle.rbegin(), end = cycle.rend(); it != end; ++it) {
-              std::cerr << " -> " << nodes[*it].name;
-            }
-            std::cerr << "\n";
-            cycle.clear(); // only print the cycle
-          }
-        }
-        return {};
-      }
-
-      depth = std::max(depth, *dep_depth + 1);
+      return false;
     }
 
-    // Important: only set `node.depth` after all children have been visited for
-    // the cycle detection.
-    node.depth = depth;
-    return depth;
+    stack.push_back({ id, 0u });
+    return true;
   }
 };
 
@@ -459,15 +594,38 @@ public:
     }
   }
 
+  // Create a latch, i.e. its output is an input to the net and its input is its next value.
   void
-  latch(std::string /* input */,
-        std::string /* output */,
+  latch(std::string input,
+        std::string output,
         blifparse::LatchType /* type */,
         std::string /* control */,
-        blifparse::LogicValue /* init */) override
+        blifparse::LogicValue init) override
   {
-    // TODO: When state transitions are used, then add <x> and <x'> variables
-    parse_error(".latch", "State transitions not (yet) supported");
+    const auto [current, inserted] =
+      net.get_or_add_node(output, { .is_defined = true, .is_input = true });
+    if (!inserted) {
+      if (!net.nodes[current].is_defined) {
+        net.nodes[current].is_input   = true;
+        net.nodes[current].is_defined = true;
+      } else {
+        parse_error(".latch - " + output, "Net '" + output + "' defined multiple times");
+        return;
+      }
+    }
+
+    const node_id_t next          = net.get_or_add_node(input, {}).first;
+    net.nodes[next].is_next_state = true;
+
+    logic_value init_value = logic_value::DONT_CARE;
+    switch (init) {
+    case blifparse::LogicValue::FALSE: init_value = logic_value::FALSE; break;
+    case blifparse::LogicValue::TRUE:  init_value = logic_value::TRUE; break;
+    default: // Both 'don't care' and 'unknown' initial values are left unconstrained.
+      break;
+    }
+
+    net.latches.push_back({ current, next, init_value });
   }
 
   void
@@ -485,187 +643,644 @@ public:
   }
 };
 
-/// Parse the net at `filename` and validate it
+// ========================================================================== //
+// Parsing input .aag or .aig file
+//
+// See "The AIGER And-Inverter Graph (AIG) Format Version 20071012" by Armin Biere.
+
+/// Reader of And-Inverter Graphs in the ASCII (`aag`) and the binary (`aig`) AIGER format.
 ///
-/// Returns true on success
-bool
-construct_net(std::string& filename, net_t& net)
+/// Each AND gate is added as a node with a single row in its cover; a complemented edge is a
+/// negated literal. Each output is added as a buffer (or inverter) of its literal such that it can
+/// carry the output's name. Similarly, the next value of each latch is a buffer (or inverter). The
+/// gates themselves are anonymous, i.e. not in the `name_map`.
+class aiger_reader
 {
-  construct_net_callback callback(net);
-  blifparse::blif_parse_filename(filename, callback);
-  if (callback.has_error()) {
-    std::cerr << "Parsing error for '" << filename << "'\n";
-    return false;
-  }
-  if (!net.validate()) {
-    std::cerr << "Validation error for '" << filename << "'\n";
-    return false;
-  }
-  return true;
-}
+private:
+  static constexpr node_id_t no_node = std::numeric_limits<node_id_t>::max();
 
-// ============================================================================================== //
-// Variable Ordering
-//
-// As stated in "Verification of Arithmetic and Datapath Circuits with Symbolic Simulation" by
-// Roope Kaivola and John O’Leary:
-//
-//   "a variable ordering that is good for an abstract specification is
-//    almost universally also good for any of its implementations"
-//
-// Hence, variable orderings should only depend on the specification circuit, i.e. `net_0`.
+  net_t& _net;
 
-template<typename RecursionOrder>
-void
-df_variable_order_rec(const node_id_t id,
-                      std::vector<unsigned>& new_ordering,
-                      unsigned& ordered_count,
-                      const net_t& net,
-                      std::vector<bool>& visited)
-{
-  if (ordered_count == net.inputs_w_order.size()) { return; }
+  std::string _content;
+  size_t _pos  = 0u;
+  size_t _line = 1u;
 
-  if (visited[id]) { return; }
-  visited[id] = true;
+  bool _binary = false;
 
-  const node_t& n = net.nodes[id];
+  // Header: maximum variable index and number of inputs, latches, outputs and AND gates.
+  uint64_t _M = 0u, _I = 0u, _L = 0u, _O = 0u, _A = 0u;
 
-  // Case: input gate
-  if (n.is_input) {
-    const unsigned old_idx = net.inputs_w_order.at(id);
-    new_ordering[old_idx]  = ordered_count++;
-    return;
+  std::vector<uint64_t> _inputs                = {};
+  std::vector<std::array<uint64_t, 3>> _latches = {};
+  std::vector<uint64_t> _outputs               = {};
+  std::vector<std::array<uint64_t, 3>> _ands   = {};
+  std::vector<std::string> _input_names        = {};
+  std::vector<std::string> _latch_names        = {};
+  std::vector<std::string> _output_names       = {};
+
+  /// Node of each AIGER variable (if any)
+  std::vector<node_id_t> _var_nodes = {};
+
+public:
+  aiger_reader(net_t& net)
+    : _net(net)
+  {}
+
+  /// Whether the file at `filename` starts with an AIGER header.
+  static bool
+  is_aiger(const std::string& filename)
+  {
+    std::ifstream in(filename, std::ios::binary);
+    char magic[4] = {};
+    in.read(magic, 4);
+    return in && (magic[0] == 'a' && (magic[1] == 'a' || magic[1] == 'i') && magic[2] == 'g'
+                  && (magic[3] == ' ' || magic[3] == '\t'));
   }
 
-  // Case: non-input gates
-  for (const node_id_t dep_id : RecursionOrder::sort(n.deps, net)) {
-    df_variable_order_rec<RecursionOrder>(dep_id, new_ordering, ordered_count, net, visited);
+  /// Parse the AIGER file at `filename` into the net.
+  ///
+  /// Returns true on success
+  bool
+  read(const std::string& filename)
+  {
+    {
+      std::ifstream in(filename, std::ios::binary);
+      if (!in) { return error("Cannot open file"); }
+
+      std::ostringstream ss;
+      ss << in.rdbuf();
+      _content = ss.str();
+    }
+
+    return read_header() && read_inputs() && read_latches() && read_outputs() && read_ands()
+      && read_symbols() && construct();
   }
-}
 
-template<typename RecursionOrder>
-std::vector<unsigned>
-df_variable_order(const net_t& net_0)
-{
-  // TODO: Break ties based on previous ordering.
+private:
+  bool
+  error(const std::string& msg)
+  {
+    std::cerr << "Parsing error at line " << _line << ": " << msg << "\n";
+    return false;
+  }
 
-  // Output value
-  std::vector<unsigned> new_ordering(net_0.inputs_w_order.size());
+  bool
+  net_error(const std::string& msg)
+  {
+    std::cerr << msg << "\n";
+    return false;
+  }
 
-  // Data structures for a depth-first traversal (of net_0 only).
-  std::vector<bool> visited(net_0.nodes.size());
-  unsigned int ordered_count = 0;
+  bool
+  at_end() const
+  {
+    return _content.size() <= _pos;
+  }
 
-  // Derive a variable order from net_0, i.e.\ the specification.
-  for (const node_id_t output : RecursionOrder::sort_outputs(net_0)) {
-    df_variable_order_rec<RecursionOrder>(output, new_ordering, ordered_count, net_0, visited);
+  void
+  skip_spaces()
+  {
+    while (!at_end() && (_content[_pos] == ' ' || _content[_pos] == '\t')) { ++_pos; }
   }
 
-  return new_ordering;
-}
+  bool
+  read_uint(uint64_t& x)
+  {
+    skip_spaces();
+    if (at_end() || !std::isdigit(static_cast<unsigned char>(_content[_pos]))) {
+      return error("Expected an unsigned integer");
+    }
+    x = 0u;
+    while (!at_end() && std::isdigit(static_cast<unsigned char>(_content[_pos]))) {
+      x = 10u * x + static_cast<uint64_t>(_content[_pos++] - '0');
+    }
+    return true;
+  }
 
-/// \brief Simple depth-first policy for `df_variable_order`.
-struct df_policy
-{
-  static std::vector<node_id_t>
-  sort(const std::vector<node_id_t>& deps, const net_t&/*net*/)
+  bool
+  read_newline()
   {
-    return deps;
+    skip_spaces();
+    if (!at_end() && _content[_pos] == '\r') { ++_pos; }
+    if (at_end() || _content[_pos] != '\n') { return error("Expected end of line"); }
+    ++_pos;
+    ++_line;
+    return true;
   }
 
-  static std::vector<node_id_t>
-  sort_outputs(const net_t& net)
+  /// Read a 7-bit variable-length encoded unsigned integer of the binary format.
+  bool
+  read_delta(uint64_t& x)
   {
-    return net.outputs_in_order;
+    x = 0u;
+    for (unsigned shift = 0u; shift < 64u; shift += 7u) {
+      if (at_end()) { return error("Unexpected end of binary AND gates"); }
+
+      const unsigned char byte = static_cast<unsigned char>(_content[_pos++]);
+      x |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+      if (!(byte & 0x80u)) { return true; }
+    }
+    return error("Invalid encoding of binary AND gate");
   }
-};
 
-/// \brief Depth-first policy for `df_variable_order` that sorts dependencies on their 'depth'.
-struct df_level_policy
-{
-  static std::vector<node_id_t>
-  sort(const std::vector<node_id_t>& deps, const net_t& net)
+  bool
+  check_literal(const uint64_t lit)
   {
-    std::vector<node_id_t> deps_copy(deps);
-    std::sort(deps_copy.begin(), deps_copy.end(), [&net](const node_id_t a, const node_id_t b) {
-      return net.nodes[a].depth > net.nodes[b].depth;
-    });
-    return deps_copy;
+    if (_M < (lit >> 1)) { return error("Literal " + std::to_string(lit) + " exceeds M"); }
+    return true;
   }
 
-  static std::vector<node_id_t>
-  sort_outputs(const net_t& net)
+  bool
+  read_header()
   {
-    std::vector<node_id_t> outputs(net.outputs_in_order);
-    std::sort(outputs.begin(), outputs.end(), [&net](const node_id_t a, const node_id_t b) {
-      return net.nodes[a].depth > net.nodes[b].depth;
-    });
+    _binary = _content.compare(0, 3, "aig") == 0;
+    if (!_binary && _content.compare(0, 3, "aag") != 0) { return error("Expected 'aag' or 'aig'"); }
+    _pos = 3u;
 
-    return outputs;
+    if (!read_uint(_M) || !read_uint(_I) || !read_uint(_L) || !read_uint(_O) || !read_uint(_A)) {
+      return false;
+    }
+
+    // AIGER 1.9 adds the number of bad state, invariant constraint, justice and fairness
+    // properties. These are not supported.
+    for (skip_spaces(); !at_end() && _content[_pos] != '\n' && _content[_pos] != '\r';
+         skip_spaces()) {
+      uint64_t properties;
+      if (!read_uint(properties)) { return false; }
+      if (properties != 0u) { return error("Properties (B, C, J, F) not supported"); }
+    }
+    if (!read_newline()) { return false; }
+
+    if (_M < _I + _L + _A) { return error("M is smaller than I + L + A"); }
+    if (_binary && _M != _I + _L + _A) { return error("M is not I + L + A"); }
+    if (std::numeric_limits<node_id_t>::max() <= _M + _L + _O + 1u) {
+      return error("Too many variables and outputs");
+    }
+    return true;
   }
-};
 
-/// \brief Depth-first policy for `df_variable_order` that obtains dependencies based on their
-///        'fanin' as in the paper "Evaluation and Improvements of Boolean Comparison Methods Based
-///        on Binary Decision Diagarms" by Fujita et al.
-struct df_fujita_policy
-{
-  static std::vector<node_id_t>
-  sort(const std::vector<node_id_t>& deps, const net_t& net)
+  bool
+  read_inputs()
   {
-    std::vector<node_id_t> deps_copy(deps);
-    std::sort(deps_copy.begin(), deps_copy.end(), [&net](const node_id_t a, const node_id_t b) {
-      // If both are non-inputs, then recurse on them based on depth.
-      if (!net.nodes[a].is_input && !net.nodes[b].is_input) {
-        return net.nodes[a].depth > net.nodes[b].depth;
+    _inputs.reserve(_I);
+    for (uint64_t i = 0u; i < _I; ++i) {
+      if (_binary) {
+        _inputs.push_back(2u * (i + 1u));
+        continue;
       }
 
-      // If both are inputs, then sort them based on their ref count (secondly their depth)
-      if (net.nodes[a].is_input && net.nodes[b].is_input) {
-        const auto a_cmp = std::tie(net.nodes[a].ref_count, net.nodes[a].depth);
-        const auto b_cmp = std::tie(net.nodes[b].ref_count, net.nodes[b].depth);
-        return a_cmp > b_cmp;
-      }
+      uint64_t lit;
+      if (!read_uint(lit) || !read_newline() || !check_literal(lit)) { return false; }
+      if (lit < 2u || (lit & 1u)) { return error("Invalid input literal " + std::to_string(lit)); }
+      _inputs.push_back(lit);
+    }
+    return true;
+  }
 
-      // Input gates with a single reference should be processed after all other gates. On the other
-      // hand, the paper follows the (arbitrary) order of the input. Yet, that is for all purposes
-      // non-deterministic.
-      //
-      // Uncommenting the code below makes input gates with 2+ references be processed prior to any
-      // recursions. In practice, recursing first seems to create the best inputs.
-      /*
-      if (net.nodes[a].ref_count > 1 && !net.nodes[b].is_input) {
-        return true;
+  /// Read the latches as the triple of their current literal, next literal, and initial value. An
+  /// uninitialised latch has its current literal as its initial value.
+  bool
+  read_latches()
+  {
+    _latches.reserve(_L);
+    for (uint64_t l = 0u; l < _L; ++l) {
+      uint64_t current = 2u * (_I + l + 1u);
+      if (!_binary) {
+        if (!read_uint(current) || !check_literal(current)) { return false; }
+        if (current < 2u || (current & 1u)) {
+          return error("Invalid latch literal " + std::to_string(current));
+        }
       }
-      if (net.nodes[b].ref_count > 1 && !net.nodes[a].is_input) {
+
+      uint64_t next, init = 0u;
+      if (!read_uint(next) || !check_literal(next)) { return false; }
+
+      skip_spaces();
+      if (!at_end() && _content[_pos] != '\n' && _content[_pos] != '\r' && !read_uint(init)) {
         return false;
       }
-      */
+      if (init != 0u && init != 1u && init != current) {
+        return error("Invalid initial value of latch " + std::to_string(current));
+      }
+      if (!read_newline()) { return false; }
 
-      // Inputs with only 1 input should be processed after recursions. Due to the above
-      // conditionals, this boils down to whether 'a' is the non-input gate.
-      return !net.nodes[a].is_input;
-    });
-    return deps_copy;
+      _latches.push_back({ current, next, init });
+    }
+    return true;
   }
 
-  static std::vector<node_id_t>
-  sort_outputs(const net_t& net)
+  bool
+  read_outputs()
   {
-    std::vector<node_id_t> outputs(net.outputs_in_order);
-    std::sort(outputs.begin(), outputs.end(), [&net](const node_id_t a, const node_id_t b) {
-      if (net.nodes[a].is_input != net.nodes[b].is_input) {
-        return net.nodes[a].is_input > net.nodes[b].is_input;
-      }
-
-      const auto a_cmp = std::tie(net.nodes[a].ref_count, net.nodes[a].depth);
-      const auto b_cmp = std::tie(net.nodes[b].ref_count, net.nodes[b].depth);
-      return a_cmp > b_cmp;
-    });
-
-    return outputs;
+    _outputs.reserve(_O);
+    for (uint64_t o = 0u; o < _O; ++o) {
+      uint64_t lit;
+      if (!read_uint(lit) || !read_newline() || !check_literal(lit)) { return false; }
+      _outputs.push_back(lit);
+    }
+    return true;
   }
-};
+
+  bool
+  read_ands()
+  {
+    _ands.reserve(_A);
+    for (uint64_t a = 0u; a < _A; ++a) {
+      uint64_t lhs, rhs0, rhs1;
+      if (_binary) {
+        lhs = 2u * (_I + _L + a + 1u);
+
+        uint64_t delta0, delta1;
+        if (!read_delta(delta0) || !read_delta(delta1)) { return false; }
+        if (lhs < delta0 || lhs - delta0 < delta1) {
+          return error("Invalid delta in binary AND gate " + std::to_string(lhs));
+        }
+        rhs0 = lhs - delta0;
+        rhs1 = rhs0 - delta1;
+      } else {
+        if (!read_uint(lhs) || !read_uint(rhs0) || !read_uint(rhs1) || !read_newline()) {
+          return false;
+        }
+        if (!check_literal(lhs) || !check_literal(rhs0) || !check_literal(rhs1)) { return false; }
+        if (lhs < 2u || (lhs & 1u)) {
+          return error("Invalid AND gate literal " + std::to_string(lhs));
+        }
+      }
+      _ands.push_back({ lhs, rhs0, rhs1 });
+    }
+    return true;
+  }
+
+  /// Read the (optional) symbol table up to the (optional) comment section.
+  bool
+  read_symbols()
+  {
+    _input_names.resize(_I);
+    _latch_names.resize(_L);
+    _output_names.resize(_O);
+
+    while (!at_end() && _content[_pos] != 'c') {
+      const char type = _content[_pos++];
+
+      uint64_t idx;
+      if (!read_uint(idx)) { return false; }
+      if (at_end() || _content[_pos] != ' ') { return error("Expected symbol name"); }
+
+      const size_t name_begin = ++_pos;
+      const size_t name_end   = std::min(_content.find('\n', name_begin), _content.size());
+
+      std::string name = _content.substr(name_begin, name_end - name_begin);
+      if (!name.empty() && name.back() == '\r') { name.pop_back(); }
+
+      _pos = name_end + 1u;
+      _line++;
+
+      switch (type) {
+      case 'i':
+        if (_I <= idx) { return error("Input symbol out of range"); }
+        _input_names[idx] = std::move(name);
+        break;
+      case 'l':
+        if (_L <= idx) { return error("Latch symbol out of range"); }
+        _latch_names[idx] = std::move(name);
+        break;
+      case 'o':
+        if (_O <= idx) { return error("Output symbol out of range"); }
+        _output_names[idx] = std::move(name);
+        break;
+      case 'b':
+      case 'c':
+      case 'j':
+      case 'f': break;
+      default: return error(std::string("Unknown symbol type '") + type + "'");
+      }
+    }
+    return true;
+  }
+
+  /// Node for the literal's variable; the constant node is created on first use.
+  node_id_t
+  var_node(const uint64_t lit)
+  {
+    const uint64_t var = lit >> 1;
+    if (_var_nodes[var] == no_node && var == 0u) {
+      _var_nodes[0] = _net.add_anonymous_node({ .name = "false", .is_defined = true });
+    }
+    return _var_nodes[var];
+  }
+
+  bool
+  construct()
+  {
+    _var_nodes.assign(_M + 1u, no_node);
+
+    _net.name_map.reserve(_I + _L + _O);
+    _net.nodes.reserve(_net.nodes.size() + _I + 2u * _L + _A + _O + 1u);
+    _net.inputs_w_order.reserve(_I);
+    _net.outputs_in_order.reserve(_O);
+
+    for (size_t i = 0u; i < _inputs.size(); ++i) {
+      const uint64_t var = _inputs[i] >> 1;
+      if (_var_nodes[var] != no_node) {
+        return net_error("Variable " + std::to_string(var) + " defined multiple times");
+      }
+
+      const std::string name = _input_names[i].empty() ? "i" + std::to_string(i) : _input_names[i];
+      const auto [id, inserted] =
+        _net.get_or_add_node(name, { .is_defined = true, .is_input = true });
+      if (!inserted) { return net_error("Net '" + name + "' defined multiple times"); }
+
+      _var_nodes[var] = id;
+      _net.inputs_w_order.insert({ id, i });
+    }
+
+    for (size_t l = 0u; l < _latches.size(); ++l) {
+      const uint64_t var = _latches[l][0] >> 1;
+      if (_var_nodes[var] != no_node) {
+        return net_error("Variable " + std::to_string(var) + " defined multiple times");
+      }
+
+      const std::string name = _latch_names[l].empty() ? "l" + std::to_string(l) : _latch_names[l];
+      const auto [id, inserted] =
+        _net.get_or_add_node(name, { .is_defined = true, .is_input = true });
+      if (!inserted) { return net_error("Net '" + name + "' defined multiple times"); }
+
+      _var_nodes[var] = id;
+    }
+
+    // Create all AND gates before adding their dependencies, since the ASCII format does not
+    // require them to be given in topological order.
+    for (const std::array<uint64_t, 3>& and_gate : _ands) {
+      const uint64_t var = and_gate[0] >> 1;
+      if (_var_nodes[var] != no_node) {
+        return net_error("Variable " + std::to_string(var) + " defined multiple times");
+      }
+      _var_nodes[var] =
+        _net.add_anonymous_node({ .name = "n" + std::to_string(var), .is_defined = true });
+    }
+
+    for (const std::array<uint64_t, 3>& and_gate : _ands) {
+      const node_id_t dep_0 = var_node(and_gate[1]);
+      const node_id_t dep_1 = var_node(and_gate[2]);
+      if (dep_0 == no_node || dep_1 == no_node) {
+        return net_error("AND gate " + std::to_string(and_gate[0]) + " uses an undefined variable");
+      }
+
+      node_t& node = _net.nodes[_var_nodes[and_gate[0] >> 1]];
+      node.deps     = { dep_0, dep_1 };
+      node.so_cover = { { literal(and_gate[1]), literal(and_gate[2]) } };
+    }
+
+    // The next value of a latch is a buffer (or inverter) of its literal.
+    for (size_t l = 0u; l < _latches.size(); ++l) {
+      const auto [current, next, init] = _latches[l];
+
+      const node_id_t dep = var_node(next);
+      if (dep == no_node) {
+        return net_error("Latch " + std::to_string(l) + " uses an undefined variable");
+      }
+
+      const node_id_t id = _net.add_anonymous_node({ .name          = "l" + std::to_string(l) + "'",
+                                                     .is_defined    = true,
+                                                     .is_next_state = true,
+                                                     .deps          = { dep },
+                                                     .so_cover      = { { literal(next) } } });
+
+      logic_value init_value = logic_value::DONT_CARE;
+      if (init != current) { init_value = init == 1u ? logic_value::TRUE : logic_value::FALSE; }
+
+      _net.latches.push_back({ _var_nodes[current >> 1], id, init_value });
+    }
+
+    for (size_t o = 0u; o < _outputs.size(); ++o) {
+      const node_id_t dep = var_node(_outputs[o]);
+      if (dep == no_node) {
+        return net_error("Output " + std::to_string(o) + " uses an undefined variable");
+      }
+
+      const std::string name =
+        _output_names[o].empty() ? "o" + std::to_string(o) : _output_names[o];
+      const auto [id, inserted] =
+        _net.get_or_add_node(name, { .is_defined = true, .is_output = true });
+      if (!inserted) { return net_error("Output '" + name + "' given twice"); }
+
+      _net.nodes[id].deps     = { dep };
+      _net.nodes[id].so_cover = { { literal(_outputs[o]) } };
+      _net.outputs_in_order.push_back(id);
+    }
+    return true;
+  }
+
+  /// The (possibly negated) literal in a cover
+  static logic_value
+  literal(const uint64_t lit)
+  {
+    return (lit & 1u) ? logic_value::FALSE : logic_value::TRUE;
+  }
+};
+
+// ========================================================================== //
+
+/// Parse the net at `filename` (either a BLIF or an AIGER file) and validate it
+///
+/// Returns true on success
+bool
+construct_net(std::string& filename, net_t& net)
+{
+  bool has_error = false;
+  if (aiger_reader::is_aiger(filename)) {
+    aiger_reader reader(net);
+    has_error = !reader.read(filename);
+  } else {
+    construct_net_callback callback(net);
+    blifparse::blif_parse_filename(filename, callback);
+    has_error = callback.has_error();
+  }
+  if (has_error) {
+    std::cerr << "Parsing error for '" << filename << "'\n";
+    return false;
+  }
+  if (!net.validate()) {
+    std::cerr << "Validation error for '" << filename << "'\n";
+    return false;
+  }
+  return true;
+}
+
+// ============================================================================================== //
+// Variable Ordering
+//
+// As stated in "Verification of Arithmetic and Datapath Circuits with Symbolic Simulation" by
+// Roope Kaivola and John O’Leary:
+//
+//   "a variable ordering that is good for an abstract specification is
+//    almost universally also good for any of its implementations"
+//
+// Hence, variable orderings should only depend on the specification circuit, i.e. `net_0`.
+
+/// \brief The current position of `id` in the variable order. Gates and latches come last.
+unsigned
+prior_position(const net_t& net, const node_id_t id)
+{
+  const auto it = net.inputs_w_order.find(id);
+  return it != net.inputs_w_order.end() ? it->second : std::numeric_limits<unsigned>::max();
+}
+
+template<typename RecursionOrder>
+void
+df_variable_order_rec(const node_id_t id,
+                      std::vector<unsigned>& new_ordering,
+                      unsigned& ordered_count,
+                      const net_t& net,
+                      std::vector<bool>& visited)
+{
+  if (ordered_count == net.inputs_w_order.size()) { return; }
+
+  if (visited[id]) { return; }
+  visited[id] = true;
+
+  const node_t& n = net.nodes[id];
+
+  // Case: input gate (latches are ordered after all inputs)
+  if (n.is_input) {
+    const auto it = net.inputs_w_order.find(id);
+    if (it != net.inputs_w_order.end()) { new_ordering[it->second] = ordered_count++; }
+    return;
+  }
+
+  // Case: non-input gates
+  for (const node_id_t dep_id : RecursionOrder::sort(n.deps, net)) {
+    df_variable_order_rec<RecursionOrder>(dep_id, new_ordering, ordered_count, net, visited);
+  }
+}
+
+template<typename RecursionOrder>
+std::vector<unsigned>
+df_variable_order(const net_t& net_0)
+{
+  // Output value
+  std::vector<unsigned> new_ordering(net_0.inputs_w_order.size());
+
+  // Data structures for a depth-first traversal (of net_0 only).
+  std::vector<bool> visited(net_0.nodes.size());
+  unsigned int ordered_count = 0;
+
+  // Derive a variable order from net_0, i.e.\ the specification.
+  for (const node_id_t output : RecursionOrder::sort_outputs(net_0)) {
+    df_variable_order_rec<RecursionOrder>(output, new_ordering, ordered_count, net_0, visited);
+  }
+
+  return new_ordering;
+}
+
+/// \brief Simple depth-first policy for `df_variable_order`.
+struct df_policy
+{
+  static std::vector<node_id_t>
+  sort(const std::vector<node_id_t>& deps, const net_t&/*net*/)
+  {
+    return deps;
+  }
+
+  static std::vector<node_id_t>
+  sort_outputs(const net_t& net)
+  {
+    return net.roots();
+  }
+};
+
+/// \brief Depth-first policy for `df_variable_order` that sorts dependencies on their 'depth'.
+///        Ties between inputs are broken by their prior ordering.
+struct df_level_policy
+{
+  static std::vector<node_id_t>
+  sort(const std::vector<node_id_t>& deps, const net_t& net)
+  {
+    std::vector<node_id_t> res(deps);
+    std::stable_sort(res.begin(), res.end(), [&net](const node_id_t a, const node_id_t b) {
+      if (net.nodes[a].depth != net.nodes[b].depth) {
+        return net.nodes[a].depth > net.nodes[b].depth;
+      }
+      return prior_position(net, a) < prior_position(net, b);
+    });
+    return res;
+  }
+
+  static std::vector<node_id_t>
+  sort_outputs(const net_t& net)
+  {
+    std::vector<node_id_t> outputs = net.roots();
+    std::stable_sort(outputs.begin(), outputs.end(), [&net](const node_id_t a, const node_id_t b) {
+      return net.nodes[a].depth > net.nodes[b].depth;
+    });
+
+    return outputs;
+  }
+};
+
+/// \brief Depth-first policy for `df_variable_order` that obtains dependencies based on their
+///        'fanin' as in the paper "Evaluation and Improvements of Boolean Comparison Methods Based
+///        on Binary Decision Diagarms" by Fujita et al. Ties between inputs are broken by their
+///        prior ordering.
+struct df_fujita_policy
+{
+  static std::vector<node_id_t>
+  sort(const std::vector<node_id_t>& deps, const net_t& net)
+  {
+    std::vector<node_id_t> res(deps);
+    std::stable_sort(res.begin(), res.end(), [&net](const node_id_t a, const node_id_t b) {
+      // If both are non-inputs, then recurse on them based on depth.
+      if (!net.nodes[a].is_input && !net.nodes[b].is_input) {
+        return net.nodes[a].depth > net.nodes[b].depth;
+      }
+
+      // If both are inputs, then sort them based on their ref count (secondly their depth)
+      if (net.nodes[a].is_input && net.nodes[b].is_input) {
+        const auto a_cmp = std::tie(net.nodes[a].ref_count, net.nodes[a].depth);
+        const auto b_cmp = std::tie(net.nodes[b].ref_count, net.nodes[b].depth);
+        if (a_cmp != b_cmp) { return a_cmp > b_cmp; }
+        return prior_position(net, a) < prior_position(net, b);
+      }
+
+      // Input gates with a single reference should be processed after all other gates. On the other
+      // hand, the paper follows the (arbitrary) order of the input. Yet, that is for all purposes
+      // non-deterministic.
+      //
+      // Uncommenting the code below makes input gates with 2+ references be processed prior to any
+      // recursions. In practice, recursing first seems to create the best inputs.
+      /*
+      if (net.nodes[a].ref_count > 1 && !net.nodes[b].is_input) {
+        return true;
+      }
+      if (net.nodes[b].ref_count > 1 && !net.nodes[a].is_input) {
+        return false;
+      }
+      */
+
+      // Inputs with only 1 input should be processed after recursions. Due to the above
+      // conditionals, this boils down to whether 'a' is the non-input gate.
+      return !net.nodes[a].is_input;
+    });
+    return res;
+  }
+
+  static std::vector<node_id_t>
+  sort_outputs(const net_t& net)
+  {
+    std::vector<node_id_t> outputs = net.roots();
+    std::stable_sort(outputs.begin(), outputs.end(), [&net](const node_id_t a, const node_id_t b) {
+      if (net.nodes[a].is_input != net.nodes[b].is_input) {
+        return net.nodes[a].is_input > net.nodes[b].is_input;
+      }
+
+      const auto a_cmp = std::tie(net.nodes[a].ref_count, net.nodes[a].depth);
+      const auto b_cmp = std::tie(net.nodes[b].ref_count, net.nodes[b].depth);
+      return a_cmp > b_cmp;
+    });
+
+    return outputs;
+  }
+};
 
 std::vector<unsigned>
 fanin_variable_order(const net_t& net_0)
@@ -733,10 +1348,15 @@ level_variable_order(const net_t& net_0)
 
   std::vector<bool> visited_nodes(nodes.size(), false);
 
-  for (const node_id_t output : net_0.outputs_in_order) {
+  for (const node_id_t output : net_0.roots()) {
     compute_input_depth(output, deepest_reference, nodes, visited_nodes);
   }
 
+  // Inputs that are never referenced are placed last.
+  for (const node_id_t input : inputs) {
+    deepest_reference.try_emplace(input, std::numeric_limits<unsigned>::max());
+  }
+
   // Sort based on deepest referenced level (break ties by prior ordering)
   const auto comparator = [&net_0, &deepest_reference](const node_id_t a, const node_id_t b) {
     const auto a_cmp = std::tie(deepest_reference.at(a), net_0.inputs_w_order.at(a));
@@ -789,23 +1409,272 @@ random_variable_order(const net_t& net)
   return permutation;
 }
 
-/// `new_ordering[i]` is the new position of the variable currently at position
-/// `i`
-void
-update_order(net_t& net, const std::vector<unsigned>& new_ordering)
+/// \brief All nodes of `net` reachable from its roots in a topological order, i.e. sorted by their
+///        depth (ties are broken by their id).
+std::vector<node_id_t>
+reachable_nodes(const net_t& net)
 {
-  for (auto& [key, value] : net.inputs_w_order) { value = new_ordering[value]; }
-}
+  std::vector<node_id_t> res;
+  std::vector<bool> visited(net.nodes.size(), false);
 
-void
-apply_variable_order(const variable_order vo, net_t& net_0, net_t& net_1)
-{
-  std::vector<unsigned> new_ordering;
+  std::vector<node_id_t> stack = net.roots();
+  while (!stack.empty()) {
+    const node_id_t id = stack.back();
+    stack.pop_back();
 
-  switch (vo) {
-  case variable_order::INPUT:
-    // Keep as is
-    return;
+    if (visited[id]) { continue; }
+    visited[id] = true;
+    res.push_back(id);
+
+    for (const node_id_t dep : net.nodes[id].deps) { stack.push_back(dep); }
+  }
+
+  std::sort(res.begin(), res.end());
+  std::stable_sort(res.begin(), res.end(), [&net](const node_id_t a, const node_id_t b) {
+    return net.nodes[a].depth < net.nodes[b].depth;
+  });
+  return res;
+}
+
+/// \brief Derive an ordering from the (fractional) `position` of every input. Ties and unreachable
+///        inputs are placed based on the prior ordering.
+std::vector<unsigned>
+ordering_from_positions(const net_t& net, const std::unordered_map<node_id_t, double>& position)
+{
+  std::vector<node_id_t> inputs;
+  inputs.reserve(net.inputs_w_order.size());
+  for (auto kv : net.inputs_w_order) { inputs.push_back(kv.first); }
+
+  const auto key = [&net, &position](const node_id_t id) {
+    const auto it = position.find(id);
+    return std::make_pair(it != position.end() ? it->second : std::numeric_limits<double>::max(),
+                          net.inputs_w_order.at(id));
+  };
+  std::sort(inputs.begin(), inputs.end(), [&key](const node_id_t a, const node_id_t b) {
+    return key(a) < key(b);
+  });
+
+  // Map into new ordering
+  std::vector<unsigned> new_ordering(inputs.size());
+  for (size_t idx = 0; idx < inputs.size(); idx++) {
+    new_ordering[net.inputs_w_order.at(inputs[idx])] = idx;
+  }
+  return new_ordering;
+}
+
+/// \brief Variable order derived with the FORCE heuristic, see `force`.
+///
+/// \details All reachable nodes are placed on a line: the inputs in their prior order and every
+///          gate at the center of gravity of its dependencies. Each gate and its dependencies form
+///          a hyperedge.
+std::vector<unsigned>
+force_variable_order(const net_t& net_0)
+{
+  const std::vector<node_t>& nodes = net_0.nodes;
+
+  const std::vector<node_id_t> vertices = reachable_nodes(net_0);
+
+  std::unordered_map<node_id_t, unsigned> vertex_idx;
+  vertex_idx.reserve(vertices.size());
+  for (unsigned v = 0; v < vertices.size(); ++v) { vertex_idx[vertices[v]] = v; }
+
+  // Hyperedges (one per gate)
+  std::vector<std::vector<unsigned>> edges;
+
+  for (unsigned v = 0; v < vertices.size(); ++v) {
+    const node_t& n = nodes[vertices[v]];
+    if (n.deps.empty()) { continue; }
+
+    std::vector<unsigned> e = { v };
+    for (const node_id_t dep : n.deps) { e.push_back(vertex_idx.at(dep)); }
+    std::sort(e.begin(), e.end());
+    e.erase(std::unique(e.begin(), e.end()), e.end());
+
+    edges.push_back(std::move(e));
+  }
+
+  // Initial placement (spread out by rank)
+  std::vector<double> center(vertices.size());
+  for (unsigned v = 0; v < vertices.size(); ++v) {
+    const node_t& n = nodes[vertices[v]];
+    if (n.deps.empty()) {
+      center[v] = prior_position(net_0, vertices[v]);
+    } else {
+      double sum = 0.0;
+      for (const node_id_t dep : n.deps) { sum += center[vertex_idx.at(dep)]; }
+      center[v] = sum / n.deps.size();
+    }
+  }
+
+  std::vector<unsigned> rank(vertices.size());
+  std::iota(rank.begin(), rank.end(), 0u);
+  std::stable_sort(rank.begin(), rank.end(), [&center](const unsigned a, const unsigned b) {
+    return center[a] < center[b];
+  });
+
+  std::vector<unsigned> position(vertices.size());
+  for (unsigned r = 0; r < rank.size(); ++r) { position[rank[r]] = r; }
+
+  position = force(edges, std::move(position));
+
+  std::unordered_map<node_id_t, double> input_position;
+  for (unsigned v = 0; v < vertices.size(); ++v) {
+    if (nodes[vertices[v]].is_input) { input_position[vertices[v]] = position[v]; }
+  }
+  return ordering_from_positions(net_0, input_position);
+}
+
+/// \brief Maximum amount of work (number of gates moved by adjacent swaps) spent on sifting.
+constexpr size_t sift_max_work = size_t(1) << 25;
+
+/// \brief Sifting, as in "Dynamic Variable Ordering for Ordered Binary Decision Diagrams" by
+///        Rudell, on an estimate of the BDDs' width derived from the net's skeleton, i.e. its wires
+///        without the gates' covers.
+///
+/// \details Each gate is placed at the position of the deepest variable in its support, i.e. where
+///          its value is known. The number of wires that cross a cut bounds the BDDs' width at that
+///          level, see "Circuit Width, Register Allocation, and Ordered Binary Decision Diagrams"
+///          by Berman. Hence, the cost of a variable order is the total length of all wires. Each
+///          variable is moved (by adjacent swaps) through the entire order and placed at the
+///          position with the smallest cost. Variables with the most references are sifted first.
+std::vector<unsigned>
+sift_variable_order(const net_t& net_0)
+{
+  const std::vector<node_t>& nodes = net_0.nodes;
+  const unsigned varcount          = net_0.inputs_w_order.size();
+
+  std::vector<node_id_t> vertices = reachable_nodes(net_0);
+
+  std::unordered_map<node_id_t, size_t> vertex_idx;
+  vertex_idx.reserve(vertices.size());
+  for (size_t v = 0; v < vertices.size(); ++v) { vertex_idx[vertices[v]] = v; }
+
+  // Include inputs that are never referenced.
+  for (const auto& [id, var] : net_0.inputs_w_order) {
+    if (vertex_idx.try_emplace(id, vertices.size()).second) { vertices.push_back(id); }
+  }
+
+  // Dependencies of each vertex and the weight of its position in the cost, i.e. the number of
+  // wires it is the end of minus the number of wires it is the start of.
+  std::vector<std::vector<size_t>> deps(vertices.size());
+  std::vector<long> weight(vertices.size(), 0);
+
+  for (size_t v = 0; v < vertices.size(); ++v) {
+    for (const node_id_t dep : nodes[vertices[v]].deps) {
+      const size_t d = vertex_idx.at(dep);
+      deps[v].push_back(d);
+      weight[v] += 1;
+      weight[d] -= 1;
+    }
+  }
+
+  // Position of each vertex: inputs are at their variable, latches are after all variables, and
+  // gates are at the deepest variable in their support. Gates are grouped by their position in
+  // topological order.
+  std::vector<size_t> input_at(varcount);
+  std::vector<unsigned> position(vertices.size(), 0u);
+  std::vector<std::vector<size_t>> gates_at(varcount + 1);
+
+  for (size_t v = 0; v < vertices.size(); ++v) {
+    const node_t& n = nodes[vertices[v]];
+    if (n.is_input) {
+      position[v] = std::min(prior_position(net_0, vertices[v]), varcount);
+      if (position[v] < varcount) { input_at[position[v]] = v; }
+      continue;
+    }
+    for (const size_t d : deps[v]) { position[v] = std::max(position[v], position[d]); }
+    gates_at[position[v]].push_back(v);
+  }
+
+  // Swap the variables at position `p` and `p+1` and return the change in cost. Only the gates at
+  // either position can move.
+  size_t work = 0;
+
+  std::vector<size_t> moved;
+  const auto swap = [&](const unsigned p) {
+    const size_t a = input_at[p];
+    const size_t b = input_at[p + 1];
+
+    long delta = weight[a] - weight[b];
+    position[a] = p + 1;
+    position[b] = p;
+    std::swap(input_at[p], input_at[p + 1]);
+
+    moved.clear();
+    std::merge(gates_at[p].begin(), gates_at[p].end(),
+               gates_at[p + 1].begin(), gates_at[p + 1].end(),
+               std::back_inserter(moved));
+    gates_at[p].clear();
+    gates_at[p + 1].clear();
+
+    for (const size_t g : moved) {
+      unsigned new_position = 0u;
+      for (const size_t d : deps[g]) { new_position = std::max(new_position, position[d]); }
+
+      delta += weight[g] * (long(new_position) - long(position[g]));
+      position[g] = new_position;
+      gates_at[new_position].push_back(g);
+    }
+
+    work += moved.size() + 1;
+    return delta;
+  };
+
+  std::vector<size_t> sift_order(input_at);
+  std::stable_sort(sift_order.begin(), sift_order.end(), [&weight](size_t a, size_t b) {
+    return weight[a] < weight[b];
+  });
+
+  for (const size_t v : sift_order) {
+    // Stop, if sifting another variable would exceed the budget.
+    if (sift_max_work < work) { break; }
+
+    long cost      = 0;
+    long best_cost = 0;
+    unsigned best  = position[v];
+
+    while (position[v] + 1 < varcount) {
+      cost += swap(position[v]);
+      if (cost < best_cost) {
+        best_cost = cost;
+        best      = position[v];
+      }
+    }
+    while (0 < position[v]) {
+      cost += swap(position[v] - 1);
+      if (cost < best_cost) {
+        best_cost = cost;
+        best      = position[v];
+      }
+    }
+    while (position[v] < best) { swap(position[v]); }
+  }
+
+  // Map into new ordering
+  std::vector<unsigned> new_ordering(varcount);
+  for (unsigned p = 0; p < varcount; ++p) {
+    new_ordering[prior_position(net_0, vertices[input_at[p]])] = p;
+  }
+  return new_ordering;
+}
+
+/// `new_ordering[i]` is the new position of the variable currently at position
+/// `i`
+void
+update_order(net_t& net, const std::vector<unsigned>& new_ordering)
+{
+  for (auto& [key, value] : net.inputs_w_order) { value = new_ordering[value]; }
+}
+
+void
+apply_variable_order(const variable_order vo, net_t& net_0, net_t& net_1)
+{
+  std::vector<unsigned> new_ordering;
+
+  switch (vo) {
+  case variable_order::INPUT:
+    // Keep as is
+    return;
 
   case variable_order::DF: {
     new_ordering = df_variable_order<df_policy>(net_0);
@@ -839,56 +1708,1003 @@ apply_variable_order(const variable_order vo, net_t& net_0, net_t& net_1)
     break;
   }
 
-  case variable_order::LEVEL: {
-    new_ordering = level_variable_order(net_0);
-    break;
+  case variable_order::LEVEL: {
+    new_ordering = level_variable_order(net_0);
+    break;
+  }
+
+  case variable_order::LEVEL_DF: {
+    apply_variable_order(variable_order::DF, net_0, net_1);
+    new_ordering = level_variable_order(net_0);
+    break;
+  }
+
+  case variable_order::FORCE: {
+    new_ordering = force_variable_order(net_0);
+    break;
+  }
+
+  case variable_order::FORCE_DF: {
+    apply_variable_order(variable_order::DF, net_0, net_1);
+    new_ordering = force_variable_order(net_0);
+    break;
+  }
+
+  case variable_order::SIFT: {
+    new_ordering = sift_variable_order(net_0);
+    break;
+  }
+
+  case variable_order::FORCE_SIFT: {
+    apply_variable_order(variable_order::FORCE, net_0, net_1);
+    new_ordering = sift_variable_order(net_0);
+    break;
+  }
+
+  case variable_order::RANDOM: {
+    new_ordering = random_variable_order(net_0);
+    break;
+  }
+
+  case variable_order::ZIP: {
+    new_ordering = zip_variable_order(net_0);
+    break;
+  }
+  }
+
+  update_order(net_0, new_ordering);
+  if (net_1.inputs_w_order.size() == net_0.inputs_w_order.size()) {
+    update_order(net_1, new_ordering);
+  }
+}
+
+// ============================================================================================== //
+// Structural Hashing
+//
+// Two circuits that are optimised versions of each other often share many gates. Before their
+// equivalence is checked, both nets are merged into a single miter in which identical gates exist
+// only once. Hence, their BDDs are also only constructed once.
+
+/// \brief Whether `node` is a buffer of its only dependency.
+bool
+is_buffer(const node_t& node)
+{
+  return node.deps.size() == 1 && node.so_cover.size() == 1
+    && node.so_cover[0][0] == (node.is_onset ? logic_value::TRUE : logic_value::FALSE);
+}
+
+/// \brief Merge structurally identical (reachable) gates of both nets in their shared node store.
+///
+/// \details The inputs of `net_1` are identified with the inputs of `net_0` at the same position.
+///          A gate is merged with an earlier one, if both have the same cover over the same
+///          (merged) dependencies up to the order of columns and rows. A buffer is merged with its
+///          dependency. The dependencies of all reachable gates are replaced by their
+///          representative.
+///
+/// \pre Both nets have been validated and the inputs of both nets have been matched.
+///
+/// \returns The representative of each node.
+std::vector<node_id_t>
+structural_hash(net_t& net_0, net_t& net_1)
+{
+  std::vector<node_t>& nodes = net_0.nodes;
+  assert(&nodes == &net_1.nodes);
+
+  std::vector<node_id_t> representative(nodes.size());
+  std::iota(representative.begin(), representative.end(), 0u);
+
+  std::vector<node_id_t> inputs_0(net_0.inputs_w_order.size());
+  for (const auto& [id, pos] : net_0.inputs_w_order) { inputs_0[pos] = id; }
+  for (const auto& [id, pos] : net_1.inputs_w_order) { representative[id] = inputs_0[pos]; }
+
+  // Reachable gates of both nets sorted by their depth, i.e. their dependencies come first.
+  std::vector<node_id_t> gates;
+  for (node_id_t id = 0; id < nodes.size(); ++id) {
+    if (!nodes[id].is_input && 0 < nodes[id].ref_count) { gates.push_back(id); }
+  }
+  std::stable_sort(gates.begin(), gates.end(), [&nodes](const node_id_t a, const node_id_t b) {
+    return nodes[a].depth < nodes[b].depth;
+  });
+
+  std::unordered_map<std::string, node_id_t> table;
+  table.reserve(gates.size());
+
+  std::vector<size_t> columns;
+  std::vector<std::string> rows;
+  std::string key;
+
+  for (const node_id_t id : gates) {
+    node_t& node = nodes[id];
+    for (node_id_t& dep : node.deps) { dep = representative[dep]; }
+
+    if (is_buffer(node)) {
+      representative[id] = node.deps[0];
+      continue;
+    }
+
+    // Key of the gate with its columns sorted by their dependency and its rows sorted afterwards.
+    columns.resize(node.deps.size());
+    std::iota(columns.begin(), columns.end(), 0u);
+    std::stable_sort(columns.begin(), columns.end(), [&node](const size_t a, const size_t b) {
+      return node.deps[a] < node.deps[b];
+    });
+
+    rows.clear();
+    for (const std::vector<logic_value>& row : node.so_cover) {
+      std::string r;
+      r.reserve(columns.size());
+      for (const size_t c : columns) { r.push_back(static_cast<char>('0' + row[c])); }
+      rows.push_back(std::move(r));
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    // The number of dependencies is included, such that the key is unambiguous, i.e. where the
+    // dependencies end and the rows (each of that length) start.
+    const size_t dep_count = node.deps.size();
+
+    key.clear();
+    key.push_back(node.is_onset ? '1' : '0');
+    key.append(reinterpret_cast<const char*>(&dep_count), sizeof(size_t));
+    for (const size_t c : columns) {
+      key.append(reinterpret_cast<const char*>(&node.deps[c]), sizeof(node_id_t));
+    }
+    for (const std::string& r : rows) { key.append(r); }
+
+    representative[id] = table.try_emplace(key, id).first->second;
+  }
+  return representative;
+}
+
+/// \brief Miter of two nets, i.e. a single net with the outputs of both after structural hashing.
+struct miter_t
+{
+  net_t net;
+
+  /// \brief For each pair of outputs that are not structurally equal, the index of the output in
+  ///        both nets and their representatives.
+  std::vector<std::tuple<size_t, node_id_t, node_id_t>> pairs = {};
+
+  /// \brief Number of gates that have been merged with another gate.
+  size_t merged_gates = 0u;
+};
+
+/// \brief Structurally hash both nets and derive their miter.
+///
+/// \remark Afterwards, only the miter may be used to construct BDDs.
+miter_t
+construct_miter(net_t& net_0, net_t& net_1)
+{
+  std::vector<node_t>& nodes                  = net_0.nodes;
+  const std::vector<node_id_t> representative = structural_hash(net_0, net_1);
+
+  miter_t miter = { { .inputs_w_order = net_0.inputs_w_order, .nodes = nodes } };
+
+  for (node_id_t id = 0; id < nodes.size(); ++id) {
+    if (!nodes[id].is_input && 0 < nodes[id].ref_count && representative[id] != id) {
+      miter.merged_gates++;
+    }
+  }
+
+  // Only the non-equal outputs are kept alive. All reference counts and depths are recomputed for
+  // the miter.
+  for (node_t& node : nodes) {
+    node.is_output = false;
+    node.depth     = 0;
+    node.ref_count = 0;
+  }
+
+  for (size_t out_idx = 0; out_idx < net_0.outputs_in_order.size(); ++out_idx) {
+    const node_id_t output_0 = representative[net_0.outputs_in_order[out_idx]];
+    const node_id_t output_1 = representative[net_1.outputs_in_order[out_idx]];
+    if (output_0 == output_1) { continue; }
+
+    miter.pairs.push_back({ out_idx, output_0, output_1 });
+    for (const node_id_t output : { output_0, output_1 }) {
+      nodes[output].is_output = true;
+      miter.net.outputs_in_order.push_back(output);
+    }
+  }
+
+  [[maybe_unused]] const bool is_valid = miter.net.validate();
+  assert(is_valid);
+
+  return miter;
+}
+
+// ============================================================================================== //
+// Gate Scheduling
+//
+// The (non-input) gates reachable from the outputs are evaluated one at a time in a topological
+// order. The order decides how many intermediate BDDs are alive at the same time.
+
+/// \brief Depth-first post-order of all non-input gates reachable from the outputs. The
+///        dependencies of each gate are visited in the order given by `sort_deps`.
+template <typename SortDeps>
+std::vector<node_id_t>
+df_schedule(const net_t& net, const SortDeps& sort_deps)
+{
+  std::vector<node_id_t> res;
+  std::vector<bool> visited(net.nodes.size(), false);
+
+  // Explicit stack of (gate, its sorted dependencies, next dependency).
+  struct frame
+  {
+    node_id_t id;
+    std::vector<node_id_t> deps;
+    size_t next;
+  };
+  std::vector<frame> stack;
+
+  const auto visit = [&](const node_id_t id) {
+    if (visited[id] || net.nodes[id].is_input) { return; }
+    visited[id] = true;
+    stack.push_back({ id, sort_deps(id), 0u });
+  };
+
+  for (const node_id_t output : net.roots()) {
+    visit(output);
+
+    while (!stack.empty()) {
+      frame& f = stack.back();
+      if (f.next < f.deps.size()) {
+        visit(f.deps[f.next++]);
+        continue;
+      }
+      res.push_back(f.id);
+      stack.pop_back();
+    }
+  }
+  return res;
+}
+
+/// \brief Gates in the order of a depth-first traversal (matching the input file).
+std::vector<node_id_t>
+df_schedule(const net_t& net)
+{
+  return df_schedule(net, [&net](const node_id_t id) { return net.nodes[id].deps; });
+}
+
+/// \brief Gates sorted by their depth, i.e. level by level from the inputs. Ties are broken by the
+///        depth-first schedule.
+std::vector<node_id_t>
+level_schedule(const net_t& net)
+{
+  std::vector<node_id_t> res = df_schedule(net);
+  std::stable_sort(res.begin(), res.end(), [&net](const node_id_t a, const node_id_t b) {
+    return net.nodes[a].depth < net.nodes[b].depth;
+  });
+  return res;
+}
+
+/// \brief Depth-first schedule that minimises the number of live BDDs in the spirit of the
+///        Sethi-Ullman register allocation: each gate's dependencies are evaluated in descending
+///        order of how many BDDs need to be alive at the same time to compute them.
+///
+/// \details The number of live BDDs for a gate is computed as if the net was a tree, i.e. shared
+///          gates are accounted for in each of their parents.
+std::vector<node_id_t>
+min_live_schedule(const net_t& net)
+{
+  // Number of live BDDs needed for each gate (computed in a topological order).
+  std::vector<unsigned> need(net.nodes.size(), 0u);
+
+  for (const node_id_t id : df_schedule(net)) {
+    std::vector<unsigned> dep_needs;
+    for (const node_id_t dep : net.nodes[id].deps) {
+      if (!net.nodes[dep].is_input) { dep_needs.push_back(need[dep]); }
+    }
+    std::sort(dep_needs.begin(), dep_needs.end(), std::greater<>());
+
+    // The i'th dependency is computed while the results of the (i-1) prior ones are kept alive.
+    unsigned n = 1u;
+    for (size_t i = 0; i < dep_needs.size(); ++i) { n = std::max<unsigned>(n, dep_needs[i] + i); }
+    need[id] = n;
+  }
+
+  return df_schedule(net, [&net, &need](const node_id_t id) {
+    std::vector<node_id_t> deps(net.nodes[id].deps);
+    std::stable_sort(deps.begin(), deps.end(), [&need](const node_id_t a, const node_id_t b) {
+      return need[a] > need[b];
+    });
+    return deps;
+  });
+}
+
+/// \brief Static schedule of all gates.
+///
+/// \remark `MIN_NODES` is dynamic, see `min_nodes_schedule` below.
+std::vector<node_id_t>
+schedule_gates(const gate_schedule gs, const net_t& net)
+{
+  switch (gs) {
+  case gate_schedule::LEVEL:    return level_schedule(net);
+  case gate_schedule::MIN_LIVE: return min_live_schedule(net);
+  case gate_schedule::DF:
+  default:                      return df_schedule(net);
+  }
+}
+
+/// \brief Dynamic schedule that greedily minimises the number of live BDD nodes, in the spirit of
+///        register-pressure-aware list scheduling.
+///
+/// \details Among all gates whose dependencies have been evaluated, the next gate is the one with
+///          the best trade-off between the BDD nodes it frees (dependencies it is the last user of)
+///          and the estimated size of its own BDD (its largest dependency). Ties are broken by the
+///          depth-first schedule. This requires the size of every gate's BDD once it is evaluated.
+class min_nodes_schedule
+{
+private:
+  struct entry
+  {
+    int64_t score;
+    unsigned position;
+    unsigned version;
+    node_id_t id;
+
+    bool
+    operator<(const entry& o) const
+    {
+      return score < o.score || (score == o.score && position > o.position);
+    }
+  };
+
+  const net_t& _net;
+
+  /// Position in the depth-first schedule.
+  std::vector<unsigned> _position;
+
+  /// Distinct (non-input) dependencies and users of each gate.
+  std::vector<std::vector<node_id_t>> _deps;
+  std::vector<std::vector<node_id_t>> _users;
+
+  /// Number of dependencies and users that are not yet evaluated.
+  std::vector<unsigned> _deps_left;
+  std::vector<unsigned> _users_left;
+
+  /// Node count of every evaluated gate.
+  std::vector<size_t> _size;
+
+  /// Whether a gate has been handed out by `pop()`.
+  std::vector<bool> _evaluated;
+
+  /// Latest version of each gate's entry in the priority queue (older ones are stale).
+  std::vector<unsigned> _version;
+
+  std::priority_queue<entry> _ready;
+
+public:
+  min_nodes_schedule(const net_t& net)
+    : _net(net)
+    , _position(net.nodes.size(), 0u)
+    , _deps(net.nodes.size())
+    , _users(net.nodes.size())
+    , _deps_left(net.nodes.size(), 0u)
+    , _users_left(net.nodes.size(), 0u)
+    , _size(net.nodes.size(), 0u)
+    , _evaluated(net.nodes.size(), false)
+    , _version(net.nodes.size(), 0u)
+  {
+    const std::vector<node_id_t> gates = df_schedule(net);
+
+    for (unsigned i = 0; i < gates.size(); ++i) {
+      const node_id_t id = gates[i];
+      _position[id]      = i;
+
+      std::vector<node_id_t>& deps = _deps[id];
+      for (const node_id_t dep : net.nodes[id].deps) {
+        if (!net.nodes[dep].is_input) { deps.push_back(dep); }
+      }
+      std::sort(deps.begin(), deps.end());
+      deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+
+      _deps_left[id] = deps.size();
+      for (const node_id_t dep : deps) {
+        _users[dep].push_back(id);
+        _users_left[dep]++;
+      }
+    }
+
+    for (const node_id_t id : gates) {
+      if (_deps_left[id] == 0) { push(id); }
+    }
+  }
+
+  bool
+  empty()
+  {
+    // Drop stale entries for gates whose score has changed since.
+    while (!_ready.empty() && _ready.top().version != _version[_ready.top().id]) { _ready.pop(); }
+    return _ready.empty();
+  }
+
+  /// \brief Obtain the next gate to evaluate.
+  node_id_t
+  pop()
+  {
+    assert(!empty());
+    const node_id_t id = _ready.top().id;
+    _ready.pop();
+
+    _evaluated[id] = true;
+    return id;
+  }
+
+  /// \brief Mark the gate `id` as evaluated with a BDD of `nodecount` many nodes.
+  void
+  done(const node_id_t id, const size_t nodecount)
+  {
+    _size[id] = nodecount;
+
+    // If only a single (unevaluated) user of a dependency remains, then that user frees it.
+    for (const node_id_t dep : _deps[id]) {
+      if (--_users_left[dep] != 1) { continue; }
+
+      for (const node_id_t user : _users[dep]) {
+        if (!_evaluated[user] && _deps_left[user] == 0) { push(user); }
+      }
+    }
+
+    // Gates that only waited for this one become ready.
+    for (const node_id_t user : _users[id]) {
+      if (--_deps_left[user] == 0) { push(user); }
+    }
+  }
+
+private:
+  void
+  push(const node_id_t id)
+  {
+    int64_t freed    = 0;
+    int64_t estimate = _net.nodes[id].deps.size();
+
+    for (const node_id_t dep : _deps[id]) {
+      const int64_t dep_size = _size[dep];
+      const node_t& dep_node = _net.nodes[dep];
+      if (_users_left[dep] == 1 && !dep_node.is_output && !dep_node.is_next_state) {
+        freed += dep_size;
+      }
+      estimate = std::max(estimate, dep_size);
+    }
+
+    _ready.push({ freed - estimate, _position[id], ++_version[id], id });
+  }
+};
+
+// ============================================================================================== //
+// Pattern detection of (small) sum-of-products covers
+
+/// \brief The kind of function a gate's cover has been recognised to be.
+enum class gate_kind
+{
+  SOP,
+  XOR,
+  MUX,
+  MAJORITY
+};
+
+constexpr size_t gate_kinds = 4;
+
+std::string
+to_string(const gate_kind k)
+{
+  switch (k) {
+  case gate_kind::SOP:      return "sop";
+  case gate_kind::XOR:      return "xor";
+  case gate_kind::MUX:      return "mux";
+  case gate_kind::MAJORITY: return "majority";
+  }
+  return "?";
+}
+
+/// \brief Largest number of dependencies for which a gate's truth table is computed.
+constexpr size_t max_pattern_deps = 6;
+
+/// \brief The function of a gate in terms of (possibly negated) columns of its cover.
+struct gate_pattern
+{
+  gate_kind kind = gate_kind::SOP;
+
+  /// \brief Columns of the operands, i.e. the parity's inputs, the MUX's selector followed by its
+  ///        then and else branch, or the majority's three inputs.
+  std::vector<size_t> columns = {};
+
+  /// \brief Whether the operand in `columns` is negated.
+  std::vector<bool> negated = {};
+
+  /// \brief Whether the output is negated (only used for XOR).
+  bool output_negated = false;
+};
+
+/// \brief Recognise a gate with at most `max_pattern_deps` dependencies as a (possibly negated)
+///        XOR, a MUX, or a majority based on its truth table.
+///
+/// \details Columns outside of the truth table's support are ignored. If the gate is none of the
+///          above, then its kind is `gate_kind::SOP`.
+gate_pattern
+classify_gate(const node_t& node)
+{
+  const size_t k = node.deps.size();
+  if (k == 0 || max_pattern_deps < k) { return {}; }
+
+  const size_t minterms = size_t(1) << k;
+  const uint64_t mask   = minterms == 64 ? ~uint64_t(0) : (uint64_t(1) << minterms) - 1;
+
+  const auto bit = [](const size_t m, const size_t col) -> bool { return (m >> col) & 1; };
+
+  // Truth table with bit `m` set if the assignment `m` to the columns satisfies the gate.
+  uint64_t tt = 0u;
+  for (const std::vector<logic_value>& row : node.so_cover) {
+    for (size_t m = 0; m < minterms; ++m) {
+      bool matches = true;
+      for (size_t col = 0; col < k && matches; ++col) {
+        matches =
+          row[col] == logic_value::DONT_CARE || (row[col] == logic_value::TRUE) == bit(m, col);
+      }
+      if (matches) { tt |= uint64_t(1) << m; }
+    }
+  }
+  if (!node.is_onset) { tt = ~tt & mask; }
+
+  const auto eval = [&tt](const size_t m) -> bool { return (tt >> m) & 1; };
+
+  std::vector<size_t> support;
+  for (size_t col = 0; col < k; ++col) {
+    for (size_t m = 0; m < minterms; ++m) {
+      if (!bit(m, col) && eval(m) != eval(m | (size_t(1) << col))) {
+        support.push_back(col);
+        break;
+      }
+    }
+  }
+  if (support.size() < 2) { return {}; }
+
+  const auto matches = [&](const auto& f) -> bool {
+    for (size_t m = 0; m < minterms; ++m) {
+      if (eval(m) != f(m)) { return false; }
+    }
+    return true;
+  };
+
+  // Parity (or its negation) of the support
+  for (const bool out : { false, true }) {
+    const auto parity = [&](const size_t m) -> bool {
+      bool res = out;
+      for (const size_t col : support) { res ^= bit(m, col); }
+      return res;
+    };
+    if (matches(parity)) {
+      return { gate_kind::XOR, support, std::vector<bool>(support.size(), false), out };
+    }
+  }
+
+  if (support.size() != 3) { return {}; }
+
+  // Multiplexer `s ? a : b` where `a` and `b` may be negated. Since `~s ? a : b` is `s ? b : a`
+  // and `~(s ? a : b)` is `s ? ~a : ~b`, this covers all polarities.
+  for (size_t s_idx = 0; s_idx < 3; ++s_idx) {
+    for (size_t a_idx = 0; a_idx < 3; ++a_idx) {
+      if (a_idx == s_idx) { continue; }
+      const size_t b_idx = 3 - s_idx - a_idx;
+
+      const size_t s = support[s_idx], a = support[a_idx], b = support[b_idx];
+      for (const bool neg_a : { false, true }) {
+        for (const bool neg_b : { false, true }) {
+          const auto mux = [&](const size_t m) -> bool {
+            return bit(m, s) ? bit(m, a) != neg_a : bit(m, b) != neg_b;
+          };
+          if (matches(mux)) { return { gate_kind::MUX, { s, a, b }, { false, neg_a, neg_b } }; }
+        }
+      }
+    }
+  }
+
+  // Majority of possibly negated inputs. Since `~maj(x,y,z)` is `maj(~x,~y,~z)`, this covers the
+  // negated output too.
+  for (size_t polarity = 0; polarity < 8; ++polarity) {
+    const auto maj = [&](const size_t m) -> bool {
+      const int votes = (bit(m, support[0]) != bit(polarity, 0))
+        + (bit(m, support[1]) != bit(polarity, 1)) + (bit(m, support[2]) != bit(polarity, 2));
+      return 2 <= votes;
+    };
+    if (matches(maj)) {
+      return { gate_kind::MAJORITY,
+               support,
+               { bit(polarity, 0), bit(polarity, 1), bit(polarity, 2) } };
+    }
+  }
+
+  return {};
+}
+
+// ============================================================================================== //
+// BDD construction of net gate
+
+struct bdd_statistics
+{
+  size_t max_roots = 0;
+#ifdef BDD_BENCHMARK_STATS
+  size_t total_processed = 0;
+  size_t total_negations = 0;
+  size_t total_applys    = 0;
+  size_t total_ites      = 0;
+  size_t max_bdd_size    = 0;
+  size_t curr_bdd_sizes  = 0;
+  size_t max_bdd_sizes   = 0;
+  size_t sum_bdd_sizes   = 0;
+  size_t max_allocated   = 0;
+  size_t sum_allocated   = 0;
+
+  size_t max_gate_applys = 0;
+
+  std::array<size_t, gate_kinds> gates                                  = {};
+  std::array<size_t, gate_kinds> gate_applys                            = {};
+  std::array<std::chrono::steady_clock::duration, gate_kinds> gate_time = {};
+#endif // BDD_BENCHMARK_STATS
+};
+
+/// \brief BDDs of the (non-input) gates that are currently alive.
+///
+/// \details Since `node_id_t` is a dense index into the node store shared by both nets, the cache
+///          is a vector indexed by it. Hence, it can also be shared by both nets.
+template <typename Adapter>
+class bdd_cache
+{
+private:
+  std::vector<std::optional<typename Adapter::dd_t>> _dds;
+  size_t _size = 0u;
+
+public:
+  bdd_cache(const size_t nodes)
+    : _dds(nodes)
+  {}
+
+  /// \brief Number of BDDs in the cache.
+  size_t
+  size() const
+  {
+    return _size;
+  }
+
+  bool
+  contains(const node_id_t id) const
+  {
+    return _dds[id].has_value();
+  }
+
+  const typename Adapter::dd_t&
+  at(const node_id_t id) const
+  {
+    assert(contains(id));
+    return *_dds[id];
+  }
+
+  void
+  insert(const node_id_t id, const typename Adapter::dd_t& dd)
+  {
+    assert(!contains(id));
+    _dds[id] = dd;
+    _size++;
+  }
+
+  void
+  erase(const node_id_t id)
+  {
+    assert(contains(id));
+    _dds[id].reset();
+    _size--;
+  }
+};
+
+/// \brief Decrease the reference count on `dep_id` and remove it from the `cache` if it is dead.
+template <typename Adapter>
+void
+deref_node_bdd(net_t& net,
+               const node_id_t dep_id,
+               bdd_cache<Adapter>& cache,
+               [[maybe_unused]] Adapter& adapter,
+               [[maybe_unused]] bdd_statistics& stats)
+{
+  node_t& dep_node = net.nodes[dep_id];
+  if (!dep_node.is_output && !dep_node.is_next_state && !dep_node.is_input
+      && --dep_node.ref_count == 0) {
+#ifdef BDD_BENCHMARK_STATS
+    const size_t dep_nodecount = adapter.nodecount(cache.at(dep_id));
+    assert(dep_nodecount <= stats.curr_bdd_sizes);
+    stats.curr_bdd_sizes -= dep_nodecount;
+#endif // BDD_BENCHMARK_STATS
+    cache.erase(dep_id);
+  }
+}
+
+/// \brief A BDD that is to be negated if `negated` is set. This allows negations of literals to be
+///        merged into the operation that consumes them, e.g. `f & ~g` is `apply_diff(f, g)`.
+template <typename Adapter>
+struct signed_bdd
+{
+  typename Adapter::dd_t dd;
+  bool negated;
+};
+
+/// \brief Evaluation of a single gate, given the BDDs of its dependencies.
+///
+/// \details A sum-of-products cover is evaluated with balanced conjunctions and disjunctions, where
+///          the operands are sorted by size, such that the smallest ones are combined first.
+///          Gates recognised as an XOR, a MUX, or a majority are instead computed directly with
+///          `apply_xor` and `ite`.
+template <typename Adapter>
+class gate_evaluator
+{
+private:
+  using dd_t     = typename Adapter::dd_t;
+  using signed_t = signed_bdd<Adapter>;
+
+  /// \brief Operand together with its number of BDD nodes (if needed to sort them).
+  using operand_t = std::pair<size_t, signed_t>;
+
+  const net_t& _net;
+  const node_t& _node;
+  const bdd_cache<Adapter>& _cache;
+  Adapter& _adapter;
+
+  [[maybe_unused]] bdd_statistics& _stats;
+
+  /// \brief Number of BDD nodes of each column (computed on demand).
+  std::vector<size_t> _column_sizes;
+
+#ifdef BDD_BENCHMARK_STATS
+  size_t _operations = 0u;
+#endif // BDD_BENCHMARK_STATS
+
+public:
+  gate_evaluator(const net_t& net,
+                 const node_t& node,
+                 const bdd_cache<Adapter>& cache,
+                 Adapter& adapter,
+                 bdd_statistics& stats)
+    : _net(net)
+    , _node(node)
+    , _cache(cache)
+    , _adapter(adapter)
+    , _stats(stats)
+  {}
+
+  /// \brief The BDD of the gate.
+  dd_t
+  evaluate(const gate_pattern& pattern)
+  {
+    switch (pattern.kind) {
+    case gate_kind::XOR:      return evaluate_xor(pattern);
+    case gate_kind::MUX:      return evaluate_mux(pattern);
+    case gate_kind::MAJORITY: return evaluate_majority(pattern);
+    case gate_kind::SOP:
+    default:                  return evaluate_sop();
+    }
+  }
+
+#ifdef BDD_BENCHMARK_STATS
+  /// \brief Number of applys and if-then-elses used for this gate.
+  size_t
+  operations() const
+  {
+    return _operations;
+  }
+#endif // BDD_BENCHMARK_STATS
+
+private:
+  dd_t
+  column(const size_t col) const
+  {
+    const node_id_t dep_id = _node.deps.at(col);
+    return _net.nodes[dep_id].is_input ? _adapter.ithvar(_net.inputs_w_order.at(dep_id))
+                                       : _cache.at(dep_id);
+  }
+
+  size_t
+  column_size(const size_t col)
+  {
+    if (_column_sizes.empty()) {
+      _column_sizes.reserve(_node.deps.size());
+      for (size_t c = 0; c < _node.deps.size(); ++c) {
+        _column_sizes.push_back(_adapter.nodecount(column(c)));
+      }
+    }
+    return _column_sizes[col];
+  }
+
+  /// \brief Account for `res` being the result of an apply.
+  dd_t
+  record_apply(dd_t&& res)
+  {
+#ifdef BDD_BENCHMARK_STATS
+    const size_t res_nodecount = _adapter.nodecount(res);
+    _stats.total_processed += res_nodecount;
+    _stats.max_bdd_size = std::max(_stats.max_bdd_size, res_nodecount);
+
+    _stats.total_applys++;
+    _operations++;
+#endif // BDD_BENCHMARK_STATS
+    return std::move(res);
+  }
+
+  dd_t
+  ite(const dd_t& f, const dd_t& g, const dd_t& h)
+  {
+    dd_t res = _adapter.ite(f, g, h);
+#ifdef BDD_BENCHMARK_STATS
+    const size_t res_nodecount = _adapter.nodecount(res);
+    _stats.total_processed += res_nodecount;
+    _stats.max_bdd_size = std::max(_stats.max_bdd_size, res_nodecount);
+
+    _stats.total_ites++;
+    _operations++;
+#endif // BDD_BENCHMARK_STATS
+    return res;
+  }
+
+  /// \brief Apply the remaining negation (if any).
+  dd_t
+  materialise(const signed_t& f)
+  {
+    if (!f.negated) { return f.dd; }
+#ifdef BDD_BENCHMARK_STATS
+    _stats.total_negations++;
+#endif // BDD_BENCHMARK_STATS
+    // TODO (ZDD): statistics on intermediate size of negation
+    return ~f.dd;
+  }
+
+  signed_t
+  conj(const signed_t& f, const signed_t& g)
+  {
+    if (!f.negated && !g.negated) {
+      return { record_apply(_adapter.apply_and(f.dd, g.dd)), false };
+    }
+    if (!f.negated) { return { record_apply(_adapter.apply_diff(f.dd, g.dd)), false }; }
+    if (!g.negated) { return { record_apply(_adapter.apply_diff(g.dd, f.dd)), false }; }
+    // ~f & ~g = ~(f | g)
+    return { record_apply(_adapter.apply_or(f.dd, g.dd)), true };
+  }
+
+  signed_t
+  disj(const signed_t& f, const signed_t& g)
+  {
+    if (!f.negated && !g.negated) {
+      return { record_apply(_adapter.apply_or(f.dd, g.dd)), false };
+    }
+    if (!f.negated) { return { record_apply(_adapter.apply_imp(g.dd, f.dd)), false }; }
+    if (!g.negated) { return { record_apply(_adapter.apply_imp(f.dd, g.dd)), false }; }
+    // ~f | ~g = ~(f & g)
+    return { record_apply(_adapter.apply_and(f.dd, g.dd)), true };
+  }
+
+  signed_t
+  exclusive_disj(const signed_t& f, const signed_t& g)
+  {
+    return { f.negated == g.negated ? record_apply(_adapter.apply_xor(f.dd, g.dd))
+                                    : record_apply(_adapter.apply_xnor(f.dd, g.dd)),
+             false };
+  }
+
+  /// \brief Combine all `operands` with the associative `op` as a balanced tree, where the operands
+  ///        first are sorted by size.
+  template <typename Op>
+  signed_t
+  reduce(std::vector<operand_t>& operands, const signed_t& identity, const Op& op)
+  {
+    if (operands.empty()) { return identity; }
+
+    std::stable_sort(operands.begin(), operands.end(), [](const operand_t& a, const operand_t& b) {
+      return a.first < b.first;
+    });
+
+    std::vector<signed_t> layer;
+    layer.reserve(operands.size());
+    for (const operand_t& o : operands) { layer.push_back(o.second); }
+
+    while (1 < layer.size()) {
+      size_t out = 0;
+      for (size_t i = 0; i + 1 < layer.size(); i += 2) {
+        layer[out++] = op(layer[i], layer[i + 1]);
+      }
+      if (layer.size() % 2 == 1) { layer[out++] = layer.back(); }
+      layer.erase(layer.begin() + out, layer.end());
+    }
+    return layer.front();
+  }
+
+  dd_t
+  evaluate_sop()
+  {
+    const auto conj_op = [this](const signed_t& f, const signed_t& g) { return conj(f, g); };
+    const auto disj_op = [this](const signed_t& f, const signed_t& g) { return disj(f, g); };
+
+    std::vector<operand_t> rows;
+    rows.reserve(_node.so_cover.size());
+
+    for (const std::vector<logic_value>& row : _node.so_cover) {
+      const size_t literal_count =
+        _node.deps.size() - std::count(row.begin(), row.end(), logic_value::DONT_CARE);
+
+      // A row without any literals is a tautology; so is the entire cover.
+      if (literal_count == 0) { return _node.is_onset ? _adapter.top() : _adapter.bot(); }
+
+      std::vector<operand_t> literals;
+      literals.reserve(literal_count);
+
+      for (size_t col = 0; col < _node.deps.size(); ++col) {
+        if (row[col] == logic_value::DONT_CARE) { continue; }
+
+        literals.push_back({ 2 < literal_count ? column_size(col) : 0u,
+                             { column(col), row[col] == logic_value::FALSE } });
+      }
+      rows.push_back({ 0u, reduce(literals, { _adapter.top(), false }, conj_op) });
+    }
+
+    if (2 < rows.size()) {
+      for (operand_t& r : rows) { r.first = _adapter.nodecount(r.second.dd); }
+    }
+
+    signed_t res = reduce(rows, { _adapter.bot(), false }, disj_op);
+    res.negated ^= !_node.is_onset;
+    return materialise(res);
   }
 
-  case variable_order::LEVEL_DF: {
-    apply_variable_order(variable_order::DF, net_0, net_1);
-    new_ordering = level_variable_order(net_0);
-    break;
-  }
+  dd_t
+  evaluate_xor(const gate_pattern& pattern)
+  {
+    const auto xor_op = [this](const signed_t& f, const signed_t& g) {
+      return exclusive_disj(f, g);
+    };
+
+    std::vector<operand_t> operands;
+    operands.reserve(pattern.columns.size());
+    for (const size_t col : pattern.columns) {
+      operands.push_back({ 2 < pattern.columns.size() ? column_size(col) : 0u,
+                           { column(col), false } });
+    }
+    // Push the output's negation into an operand; it is then merged into an `apply_xnor`.
+    operands.front().second.negated = pattern.output_negated;
 
-  case variable_order::RANDOM: {
-    new_ordering = random_variable_order(net_0);
-    break;
+    return materialise(reduce(operands, { _adapter.bot(), false }, xor_op));
   }
 
-  case variable_order::ZIP: {
-    new_ordering = zip_variable_order(net_0);
-    break;
-  }
-  }
+  dd_t
+  evaluate_mux(const gate_pattern& pattern)
+  {
+    const dd_t s   = column(pattern.columns[0]);
+    signed_t then_ = { column(pattern.columns[1]), pattern.negated[1] };
+    signed_t else_ = { column(pattern.columns[2]), pattern.negated[2] };
 
-  update_order(net_0, new_ordering);
-  if (net_1.inputs_w_order.size() == net_0.inputs_w_order.size()) {
-    update_order(net_1, new_ordering);
-  }
-}
+    // s ? ~a : ~b = ~(s ? a : b)
+    const bool negate_output = then_.negated && else_.negated;
+    if (negate_output) { then_.negated = else_.negated = false; }
 
-// ============================================================================================== //
-// BDD construction of net gate
+    return materialise({ ite(s, materialise(then_), materialise(else_)), negate_output });
+  }
 
-struct bdd_statistics
-{
-#ifdef BDD_BENCHMARK_STATS
-  size_t total_processed = 0;
-  size_t total_negations = 0;
-  size_t total_applys    = 0;
-  size_t max_bdd_size    = 0;
-  size_t curr_bdd_sizes  = 0;
-  size_t max_bdd_sizes   = 0;
-  size_t sum_bdd_sizes   = 0;
-  size_t max_roots       = 0;
-  size_t max_allocated   = 0;
-  size_t sum_allocated   = 0;
-#endif // BDD_BENCHMARK_STATS
+  dd_t
+  evaluate_majority(const gate_pattern& pattern)
+  {
+    const signed_t a = { column(pattern.columns[0]), pattern.negated[0] };
+    const signed_t b = { column(pattern.columns[1]), pattern.negated[1] };
+    const signed_t c = { column(pattern.columns[2]), pattern.negated[2] };
+
+    // maj(a,b,c) = a ? b | c : b & c, where both branches are negated iff `b` and `c` are.
+    const signed_t b_or_c  = disj(b, c);
+    const signed_t b_and_c = conj(b, c);
+    assert(b_or_c.negated == b_and_c.negated);
+
+    const dd_t res =
+      a.negated ? ite(a.dd, b_and_c.dd, b_or_c.dd) : ite(a.dd, b_or_c.dd, b_and_c.dd);
+    return materialise({ res, b_or_c.negated });
+  }
 };
 
-template <typename Adapter>
-using bdd_cache = std::unordered_map<node_id_t, typename Adapter::dd_t>;
-
+/// \brief Construct the BDD for the (non-input) gate `node_id` and add it to the `cache`.
+///
+/// \pre The BDDs of all (non-input) dependencies are in the `cache`, i.e. the gates are evaluated
+///      in a topological order, e.g. `schedule_gates(...)`.
 template <typename Adapter>
 typename Adapter::dd_t
 construct_node_bdd(net_t& net,
@@ -897,126 +2713,59 @@ construct_node_bdd(net_t& net,
                    Adapter& adapter,
                    bdd_statistics& stats)
 {
-  const auto lookup_cache = cache.find(node_id);
-  if (lookup_cache != cache.end()) { return lookup_cache->second; }
-
   const node_t& node_data = net.nodes[node_id];
-  if (node_data.is_input) { return adapter.ithvar(net.inputs_w_order.at(node_id)); }
-
-  typename Adapter::dd_t so_cover_bdd = adapter.bot();
-#ifdef BDD_BENCHMARK_STATS
-  size_t so_nodecount = adapter.nodecount(so_cover_bdd);
-  assert(so_nodecount <= 1);
-  stats.curr_bdd_sizes += so_nodecount;
-#endif // BDD_BENCHMARK_STATS
-
-  for (size_t row_idx = 0; row_idx < node_data.so_cover.size(); row_idx++) {
-    typename Adapter::dd_t tmp = adapter.top();
-
-    for (size_t column_idx = 0; column_idx < node_data.deps.size(); column_idx++) {
-      const node_id_t dep_id         = node_data.deps.at(column_idx);
-      typename Adapter::dd_t dep_bdd = construct_node_bdd(net, dep_id, cache, adapter, stats);
+  assert(!node_data.is_input);
+  assert(!cache.contains(node_id));
 
-      // Add to row accumulation in 'tmp'
-      const logic_value lval = node_data.so_cover.at(row_idx).at(column_idx);
-      switch (lval) {
-      case logic_value::FALSE: tmp &= ~dep_bdd;
 #ifdef BDD_BENCHMARK_STATS
-        // TODO (ZDD): intermediate size of negation
-        {
-          const size_t tmp_nodecount = adapter.nodecount(tmp);
-          stats.total_processed += tmp_nodecount;
-
-          stats.total_negations++;
-          stats.total_applys++;
-
-          stats.max_bdd_size = std::max(stats.max_bdd_size, tmp_nodecount);
-        }
+  const time_point t_before = now();
 #endif // BDD_BENCHMARK_STATS
-        break;
 
-      case logic_value::TRUE: tmp &= dep_bdd;
-#ifdef BDD_BENCHMARK_STATS
-        {
-          const size_t tmp_nodecount = adapter.nodecount(tmp);
-          stats.total_processed += tmp_nodecount;
-
-          stats.total_applys++;
-
-          stats.max_bdd_size = std::max(stats.max_bdd_size, tmp_nodecount);
-        }
-#endif // BDD_BENCHMARK_STATS
-        break;
+  const gate_pattern pattern = classify_gate(node_data);
 
-      case logic_value::DONT_CARE:
-        // Just do nothing
-        break;
-      }
+  gate_evaluator<Adapter> evaluator(net, node_data, cache, adapter, stats);
+  const typename Adapter::dd_t node_bdd = evaluator.evaluate(pattern);
 
-      // Decrease reference count on dependency if we are on the last row.
-      if (row_idx == node_data.so_cover.size() - 1) {
-        node_t& dep_node = net.nodes[dep_id];
-        if (!dep_node.is_output && !dep_node.is_input && --dep_node.ref_count == 0) {
-          cache.erase(dep_id);
 #ifdef BDD_BENCHMARK_STATS
-          const size_t dep_nodecount = adapter.nodecount(dep_bdd);
-          assert(dep_nodecount <= stats.curr_bdd_sizes);
-          stats.curr_bdd_sizes -= dep_nodecount;
-#endif // BDD_BENCHMARK_STATS
-        }
-      }
-    }
+  const time_point t_after = now();
 
-    so_cover_bdd |= tmp;
+  const size_t kind = static_cast<size_t>(pattern.kind);
+  stats.gates[kind]++;
+  stats.gate_applys[kind] += evaluator.operations();
+  stats.gate_time[kind] += t_after - t_before;
 
-#ifdef BDD_BENCHMARK_STATS
-    assert(so_nodecount <= stats.curr_bdd_sizes);
-    stats.curr_bdd_sizes -= so_nodecount;
-    so_nodecount = adapter.nodecount(so_cover_bdd);
-    stats.curr_bdd_sizes += so_nodecount;
-
-    stats.total_processed += so_nodecount;
-    stats.total_applys++;
+  stats.max_gate_applys = std::max(stats.max_gate_applys, evaluator.operations());
 
-    stats.max_bdd_size = std::max(stats.max_bdd_size, so_nodecount);
+  stats.curr_bdd_sizes += adapter.nodecount(node_bdd);
 
-    stats.max_bdd_sizes = std::max(stats.max_bdd_sizes, stats.curr_bdd_sizes);
-    stats.sum_bdd_sizes += stats.curr_bdd_sizes;
+  stats.max_bdd_sizes = std::max(stats.max_bdd_sizes, stats.curr_bdd_sizes);
+  stats.sum_bdd_sizes += stats.curr_bdd_sizes;
 
-    stats.max_allocated = std::max(stats.max_allocated, adapter.allocated_nodes());
-    stats.sum_allocated += adapter.allocated_nodes();
+  stats.max_allocated = std::max(stats.max_allocated, adapter.allocated_nodes());
+  stats.sum_allocated += adapter.allocated_nodes();
 #endif // BDD_BENCHMARK_STATS
-  }
 
-  if (!node_data.is_onset) {
-    so_cover_bdd = ~so_cover_bdd;
-#ifdef BDD_BENCHMARK_STATS
-    stats.total_negations++;
-#endif // BDD_BENCHMARK_STATS
-    // TODO (ZDD): remaining statistics
+  for (const node_id_t dep_id : node_data.deps) {
+    deref_node_bdd(net, dep_id, cache, adapter, stats);
   }
 
-  cache.insert({ node_id, so_cover_bdd });
-#ifdef BDD_BENCHMARK_STATS
+  cache.insert(node_id, node_bdd);
   stats.max_roots = std::max(stats.max_roots, cache.size());
-#endif // BDD_BENCHMARK_STATS
-  return so_cover_bdd;
+  return node_bdd;
 }
 
 // ============================================================================================== //
 // Construct the BDD for each output gate
-template <typename Adapter>
+//
+// After each gate, `after_gate()` is called; the construction is stopped early if it returns false.
+template <typename Adapter, typename AfterGate>
 std::pair<int, time_duration>
 construct_net_bdd(const std::string& filename,
                   net_t& net,
                   bdd_cache<Adapter>& cache,
-                  Adapter& adapter)
+                  Adapter& adapter,
+                  const AfterGate& after_gate)
 {
-  if (cache.size() > 0) {
-    std::cerr << "Given BDD cache is non-empty";
-    return { -1, 0 };
-  }
-
   std::cout << json::indent << json::brace_open << json::endl;
   std::cout << json::field("path") << json::value(filename) << json::comma << json::endl;
   std::cout << json::field("input gates") << json::value(net.inputs_w_order.size()) << json::comma
@@ -1027,17 +2776,44 @@ construct_net_bdd(const std::string& filename,
             << json::endl;
   std::cout << json::endl;
 
-  const time_point t_construct_before = now();
+  // The cache is shared with the nets constructed before, i.e. it already contains their outputs.
   bdd_statistics stats;
-  for (const node_id_t output : net.outputs_in_order) {
-    construct_node_bdd(net, output, cache, adapter, stats);
+  stats.max_roots = cache.size();
+
+  const size_t prior_roots = cache.size();
+
+  // Time spent by the `min-nodes` schedule on counting the nodes of each gate's BDD. This is not
+  // part of constructing the BDDs and so it is excluded from the construction time.
+  std::chrono::steady_clock::duration schedule_overhead = {};
+
+  const time_point t_construct_before = now();
+  if (schedule == gate_schedule::MIN_NODES) {
+    min_nodes_schedule gates(net);
+    while (!gates.empty()) {
+      const node_id_t gate = gates.pop();
+      const typename Adapter::dd_t gate_bdd = construct_node_bdd(net, gate, cache, adapter, stats);
+
+      const time_point t_schedule_before = now();
+      gates.done(gate, adapter.nodecount(gate_bdd));
+      schedule_overhead += now() - t_schedule_before;
+
+      if (!after_gate()) { break; }
+    }
+  } else {
+    for (const node_id_t gate : schedule_gates(schedule, net)) {
+      construct_node_bdd(net, gate, cache, adapter, stats);
+      if (!after_gate()) { break; }
+    }
   }
   const time_point t_construct_after = now();
 
   size_t sum_final_sizes = 0;
   size_t max_final_size  = 0;
-  for (auto kv : cache) {
-    size_t nodecount = adapter.nodecount(kv.second);
+  for (const node_id_t output : net.outputs_in_order) {
+    // Skip inputs and outputs not constructed due to stopping early.
+    if (net.nodes[output].is_input || !cache.contains(output)) { continue; }
+
+    const size_t nodecount = adapter.nodecount(cache.at(output));
     sum_final_sizes += nodecount;
     max_final_size = std::max(max_final_size, nodecount);
   }
@@ -1051,12 +2827,10 @@ construct_net_bdd(const std::string& filename,
             << json::endl;
   std::cout << json::brace_close << json::comma << json::endl;
 
-#ifdef BDD_BENCHMARK_STATS
   std::cout << json::field("life_time") << json::brace_open << json::endl;
+#ifdef BDD_BENCHMARK_STATS
   std::cout << json::field("total processed (nodes)") << stats.total_processed << json::comma
             << json::endl;
-  std::cout << json::field("max roots") << json::value(stats.max_roots) << json::comma
-            << json::endl;
   std::cout << json::field("size[max] (nodes)") << json::value(stats.max_bdd_size) << json::comma
             << json::endl;
   std::cout << json::field("sizes[sum] (nodes)") << json::value(stats.sum_bdd_sizes) << json::comma
@@ -1065,45 +2839,86 @@ construct_net_bdd(const std::string& filename,
             << json::endl;
   std::cout << json::field("allocated[sum]") << json::value(stats.sum_allocated) << json::comma
             << json::endl;
-  std::cout << json::field("allocated[max]") << json::value(stats.max_allocated) << json::endl;
+  std::cout << json::field("allocated[max]") << json::value(stats.max_allocated) << json::comma
+            << json::endl;
+#endif // BDD_BENCHMARK_STATS
+  std::cout << json::field("max roots") << json::value(stats.max_roots - prior_roots)
+            << json::endl;
   std::cout << json::brace_close << json::comma << json::endl;
 
+#ifdef BDD_BENCHMARK_STATS
   std::cout << json::field("operation count") << json::brace_open << json::endl;
   std::cout << json::field("apply") << json::value(stats.total_applys) << json::comma << json::endl;
-  std::cout << json::field("not") << json::value(stats.total_negations) << json::endl;
+  std::cout << json::field("ite") << json::value(stats.total_ites) << json::comma << json::endl;
+  std::cout << json::field("not") << json::value(stats.total_negations) << json::comma
+            << json::endl;
+  std::cout << json::field("per gate[max]") << json::value(stats.max_gate_applys) << json::endl;
+  std::cout << json::brace_close << json::comma << json::endl;
+
+  std::cout << json::field("gates") << json::brace_open << json::endl;
+  for (size_t kind = 0; kind < gate_kinds; ++kind) {
+    const time_duration kind_time =
+      std::chrono::duration_cast<std::chrono::milliseconds>(stats.gate_time[kind]).count();
+
+    std::cout << json::field(to_string(static_cast<gate_kind>(kind))) << json::brace_open
+              << json::endl;
+    std::cout << json::field("count") << json::value(stats.gates[kind]) << json::comma
+              << json::endl;
+    std::cout << json::field("operations") << json::value(stats.gate_applys[kind]) << json::comma
+              << json::endl;
+    std::cout << json::field("time (ms)") << json::value(kind_time) << json::endl;
+    std::cout << json::brace_close;
+    if (kind + 1 < gate_kinds) { std::cout << json::comma; }
+    std::cout << json::endl;
+  }
   std::cout << json::brace_close << json::comma << json::endl;
 #endif // BDD_BENCHMARK_STATS
 
-  const time_duration total_time = duration_ms(t_construct_before, t_construct_after);
+  const time_duration overhead_time =
+    std::chrono::duration_cast<std::chrono::milliseconds>(schedule_overhead).count();
+  const time_duration total_time =
+    std::chrono::duration_cast<std::chrono::milliseconds>(t_construct_after - t_construct_before
+                                                          - schedule_overhead)
+      .count();
+  std::cout << json::field("schedule overhead (ms)") << json::value(overhead_time) << json::comma
+            << json::endl;
   std::cout << json::field("time (ms)") << total_time << json::endl;
   std::cout << json::brace_close; // << json::endl
 
   return { 0, total_time };
 }
 
+template <typename Adapter>
+std::pair<int, time_duration>
+construct_net_bdd(const std::string& filename,
+                  net_t& net,
+                  bdd_cache<Adapter>& cache,
+                  Adapter& adapter)
+{
+  return construct_net_bdd(filename, net, cache, adapter, []() { return true; });
+}
+
 // ============================================================================================== //
 // Test equivalence of every output gate (in-order they were given)
 template <typename Adapter>
 std::pair<bool, time_duration>
 verify_outputs(Adapter& adapter,
                const net_t& net_0,
-               const bdd_cache<Adapter>& cache_0,
                const net_t& net_1,
-               const bdd_cache<Adapter>& cache_1)
+               const bdd_cache<Adapter>& cache)
 {
   // The number of outputs need to match - otherwise, what gate(s) ought to be compared to which?
   assert(net_0.outputs_in_order.size() == net_1.outputs_in_order.size());
 
-  // The cache should have exactly as many entries as there are outputs that are
-  // not inputs as well.
-  assert(cache_0.size()
+  // The cache should have exactly as many entries as there are outputs (of both nets) that are not
+  // inputs as well.
+  assert(cache.size()
          == size_t(std::count_if(net_0.outputs_in_order.begin(),
                                  net_0.outputs_in_order.end(),
-                                 [&net_0](node_id_t id) { return !net_0.nodes[id].is_input; })));
-  assert(cache_1.size()
-         == size_t(std::count_if(net_1.outputs_in_order.begin(),
-                                 net_1.outputs_in_order.end(),
-                                 [&net_1](node_id_t id) { return !net_1.nodes[id].is_input; })));
+                                 [&net_0](node_id_t id) { return !net_0.nodes[id].is_input; }))
+           + size_t(std::count_if(net_1.outputs_in_order.begin(),
+                                  net_1.outputs_in_order.end(),
+                                  [&net_1](node_id_t id) { return !net_1.nodes[id].is_input; })));
 
   std::cout << json::field("equal") << json::brace_open << json::endl;
 
@@ -1116,10 +2931,10 @@ verify_outputs(Adapter& adapter,
 
     const typename Adapter::dd_t bdd_0 = net_0.nodes[output_0].is_input
       ? adapter.ithvar(net_0.inputs_w_order.at(output_0))
-      : cache_0.at(output_0);
+      : cache.at(output_0);
     const typename Adapter::dd_t bdd_1 = net_1.nodes[output_1].is_input
       ? adapter.ithvar(net_1.inputs_w_order.at(output_1))
-      : cache_1.at(output_1);
+      : cache.at(output_1);
 
     if (bdd_0 != bdd_1) {
       if (match_io_names) {
@@ -1142,6 +2957,266 @@ verify_outputs(Adapter& adapter,
   return { ret_value, time };
 }
 
+// ============================================================================================== //
+// Test equivalence of every output gate of a miter (in-order they were given) while constructing it
+
+/// \brief Comparison of the miter's output pairs as soon as the BDDs of both are constructed.
+template <typename Adapter>
+class output_sweep
+{
+private:
+  const net_t& _net_0;
+  const net_t& _net_1;
+  const miter_t& _miter;
+
+  const bdd_cache<Adapter>& _cache;
+  Adapter& _adapter;
+
+  /// \brief Index of the next pair in the miter to compare.
+  size_t _next = 0u;
+
+  bool _equal = true;
+
+public:
+  output_sweep(const net_t& net_0,
+               const net_t& net_1,
+               const miter_t& miter,
+               const bdd_cache<Adapter>& cache,
+               Adapter& adapter)
+    : _net_0(net_0)
+    , _net_1(net_1)
+    , _miter(miter)
+    , _cache(cache)
+    , _adapter(adapter)
+  {}
+
+  /// \brief Compare all output pairs (in order) for which both BDDs are available.
+  ///
+  /// \returns Whether all compared outputs so far are equal.
+  bool
+  operator()()
+  {
+    while (_equal && _next < _miter.pairs.size()) {
+      const auto [out_idx, output_0, output_1] = _miter.pairs[_next];
+      if (!is_available(output_0) || !is_available(output_1)) { break; }
+
+      if (bdd_of(output_0) != bdd_of(output_1)) {
+        const std::string& name_0 = _net_0.nodes[_net_0.outputs_in_order[out_idx]].name;
+        const std::string& name_1 = _net_1.nodes[_net_1.outputs_in_order[out_idx]].name;
+        if (match_io_names) {
+          assert(name_0 == name_1);
+          std::cerr << "Output gate '" << name_0 << "' differs!\n";
+        } else {
+          std::cerr << "Output gate ['" << name_0 << "'/'" << name_1 << "'] differs!\n";
+        }
+        _equal = false;
+      }
+      ++_next;
+    }
+    return _equal;
+  }
+
+  /// \brief Number of output pairs that have been compared.
+  size_t
+  compared() const
+  {
+    return _next;
+  }
+
+  /// \brief Whether all output pairs have been compared and are equal.
+  bool
+  equal() const
+  {
+    return _equal && _next == _miter.pairs.size();
+  }
+
+private:
+  bool
+  is_available(const node_id_t id) const
+  {
+    return _miter.net.nodes[id].is_input || _cache.contains(id);
+  }
+
+  typename Adapter::dd_t
+  bdd_of(const node_id_t id) const
+  {
+    return _miter.net.nodes[id].is_input ? _adapter.ithvar(_miter.net.inputs_w_order.at(id))
+                                         : _cache.at(id);
+  }
+};
+
+// ============================================================================================== //
+// Sequential circuits
+//
+// The inputs and latches are interleaved pairs of current/next variables: the input (or latch) at
+// position `i` is the variable `2i` (and its next value is `2i+1`). This matches the variable
+// convention of `relnext`. The latches are positioned after all inputs.
+
+/// \brief Number of latches in both nets.
+size_t
+latch_count(const net_t& net_0, const net_t& net_1)
+{
+  return net_0.latches.size() + net_1.latches.size();
+}
+
+/// \brief Net with the outputs and next-state functions of both nets (if `net_1` is non-empty) and
+///        with the variable of each input and latch.
+///
+/// \remark The inputs of `net_1` are identified with the inputs of `net_0` at the same position.
+///         The latches of both nets are distinct, i.e. their product machine is constructed.
+net_t
+sequential_net(const net_t& net_0, const net_t& net_1)
+{
+  net_t res = { .nodes = net_0.nodes };
+
+  const size_t inputs = net_0.inputs_w_order.size();
+  res.inputs_w_order.reserve(2 * inputs + latch_count(net_0, net_1));
+
+  size_t latch_idx = inputs;
+  for (const net_t* net : { &net_0, &net_1 }) {
+    for (const auto& [id, pos] : net->inputs_w_order) {
+      res.inputs_w_order.insert({ id, 2 * pos });
+    }
+    for (const latch_t& l : net->latches) {
+      res.inputs_w_order.insert({ l.current, 2 * latch_idx++ });
+    }
+
+    res.outputs_in_order.insert(res.outputs_in_order.end(),
+                                net->outputs_in_order.begin(),
+                                net->outputs_in_order.end());
+    for (const latch_t& l : net->latches) { res.outputs_in_order.push_back(l.next); }
+  }
+  return res;
+}
+
+/// \brief Forward reachability from the initial states of the latches in both nets. If `verify`
+///        is set, then additionally the outputs of both nets are compared in each reachable state,
+///        i.e. their sequential equivalence is checked by their product machine.
+///
+/// \pre The BDDs of all outputs and next-state functions of `seq` are in the `cache`.
+///
+/// \returns Whether the nets are equivalent and the time spent (ms).
+template <typename Adapter>
+std::pair<bool, time_duration>
+reachability(Adapter& adapter,
+             const net_t& net_0,
+             const net_t& net_1,
+             const net_t& seq,
+             const bdd_cache<Adapter>& cache,
+             const bool verify)
+{
+  using dd_t = typename Adapter::dd_t;
+
+  const auto bdd_of = [&](const node_id_t id) -> dd_t {
+    return seq.nodes[id].is_input ? adapter.ithvar(seq.inputs_w_order.at(id)) : cache.at(id);
+  };
+
+  // ============================================================================================
+  // Transition relation and initial states
+  const time_point t_relation_before = now();
+
+  dd_t relation = adapter.top();
+  dd_t initial  = adapter.top();
+
+  for (const net_t* net : { &net_0, &net_1 }) {
+    for (const latch_t& l : net->latches) {
+      const int var = seq.inputs_w_order.at(l.current);
+      relation =
+        adapter.apply_and(relation, adapter.apply_xnor(adapter.ithvar(var + 1), bdd_of(l.next)));
+
+      switch (l.init) {
+      case logic_value::FALSE: initial = adapter.apply_diff(initial, adapter.ithvar(var)); break;
+      case logic_value::TRUE:  initial = adapter.apply_and(initial, adapter.ithvar(var)); break;
+      case logic_value::DONT_CARE: break;
+      }
+    }
+  }
+
+  // States (and inputs) where some pair of outputs differ
+  dd_t differ = adapter.bot();
+  if (verify) {
+    for (size_t out_idx = 0; out_idx < net_0.outputs_in_order.size(); ++out_idx) {
+      differ = adapter.apply_or(differ,
+                                adapter.apply_xor(bdd_of(net_0.outputs_in_order[out_idx]),
+                                                  bdd_of(net_1.outputs_in_order[out_idx])));
+    }
+  }
+
+  const dd_t support = adapter.cube([](int) { return true; });
+
+  const time_point t_relation_after = now();
+  const time_duration relation_time = duration_ms(t_relation_before, t_relation_after);
+
+  std::cout << json::field("transition relation") << json::brace_open << json::endl;
+  std::cout << json::field("latches") << json::value(latch_count(net_0, net_1)) << json::comma
+            << json::endl;
+  std::cout << json::field("size (nodes)") << json::value(adapter.nodecount(relation))
+            << json::comma << json::endl;
+  std::cout << json::field("time (ms)") << json::value(relation_time) << json::endl;
+  std::cout << json::brace_close << json::comma << json::endl;
+
+  // ============================================================================================
+  // Breadth-first search from the initial states
+  const time_point t_reach_before = now();
+
+  dd_t reachable = initial;
+  dd_t frontier  = initial;
+
+  size_t symbolic_steps = 0;
+  bool equal            = true;
+
+  while (true) {
+    if (verify && adapter.apply_and(frontier, differ) != adapter.bot()) {
+      equal = false;
+      break;
+    }
+
+    frontier = adapter.apply_diff(adapter.relnext(frontier, relation, support), reachable);
+    symbolic_steps += 1;
+
+    if (frontier == adapter.bot()) { break; }
+    reachable = adapter.apply_or(reachable, frontier);
+  }
+
+  const time_point t_reach_after = now();
+  const time_duration reach_time = duration_ms(t_reach_before, t_reach_after);
+
+  std::cout << json::field("reachability") << json::brace_open << json::endl;
+  std::cout << json::field("size (nodes)") << json::value(adapter.nodecount(reachable))
+            << json::comma << json::endl;
+  std::cout << json::field("satcount (states)")
+            << json::value(adapter.satcount_exact(reachable, latch_count(net_0, net_1)))
+            << json::comma << json::endl;
+  std::cout << json::field("symbolic steps") << json::value(symbolic_steps) << json::comma
+            << json::endl;
+  std::cout << json::field("time (ms)") << json::value(reach_time) << json::endl;
+  std::cout << json::brace_close << json::comma << json::endl;
+
+  if (verify) {
+    if (!equal) {
+      for (size_t out_idx = 0; out_idx < net_0.outputs_in_order.size(); ++out_idx) {
+        const node_id_t output_0 = net_0.outputs_in_order[out_idx];
+        const node_id_t output_1 = net_1.outputs_in_order[out_idx];
+
+        const dd_t output_differ = adapter.apply_xor(bdd_of(output_0), bdd_of(output_1));
+        if (adapter.apply_and(frontier, output_differ) == adapter.bot()) { continue; }
+
+        std::cerr << "Output gate ['" << net_0.nodes[output_0].name << "'/'"
+                  << net_1.nodes[output_1].name << "'] differs in a state reachable in "
+                  << symbolic_steps << " steps!\n";
+        break;
+      }
+    }
+
+    std::cout << json::field("equal") << json::brace_open << json::endl;
+    std::cout << json::field("result") << json::value(equal) << json::comma << json::endl;
+    std::cout << json::field("depth") << json::value(symbolic_steps) << json::endl;
+    std::cout << json::brace_close << json::comma << json::endl;
+  }
+
+  return { equal, relation_time + reach_time };
+}
+
 // ============================================================================================== //
 
 /// Perform name-based matching of inputs and outputs
@@ -1240,26 +3315,120 @@ run_picotrav(int argc, char** argv)
   // Derive variable order
   apply_variable_order(var_order, net_0, net_1);
 
+  // Sequential circuits are analysed by reachability of their (product) state machine.
+  const bool is_sequential = latch_count(net_0, net_1) != 0;
+
+  if constexpr (!Adapter::supports_relnext) {
+    if (is_sequential) {
+      std::cerr << "Sequential circuits (latches) are not supported with " << Adapter::dd << "s\n";
+      return -1;
+    }
+  }
+
+  // Merge both (combinational) nets into a miter
+  std::optional<miter_t> miter;
+  time_duration strash_time = 0;
+
+  if (verify_networks && equiv_check == equivalence_check::SWEEP && !is_sequential) {
+    const time_point t_strash_before = now();
+    miter.emplace(construct_miter(net_0, net_1));
+    const time_point t_strash_after = now();
+
+    strash_time = duration_ms(t_strash_before, t_strash_after);
+  }
+
   // ============================================================================================
   // Initialise BDD package manager
-  const size_t varcount = net_0.inputs_w_order.size();
+  const size_t varcount = is_sequential
+    ? 2 * (net_0.inputs_w_order.size() + latch_count(net_0, net_1))
+    : net_0.inputs_w_order.size();
 
   return run<Adapter>("Picotrav", varcount, [&](Adapter& adapter) {
     std::cout << json::field("variable order") << json::value(to_string(var_order)) << json::comma
               << json::endl;
+    std::cout << json::field("schedule") << json::value(to_string(schedule)) << json::comma
+              << json::endl;
+    std::cout << json::field("equivalence check")
+              << json::value(is_sequential ? "product machine" : to_string(equiv_check))
+              << json::comma << json::endl;
     std::cout << json::endl;
 
+    // ============================================================================================
+    // Construct BDDs for the outputs and latches of the net(s) and search the state space
+    if constexpr (Adapter::supports_relnext) {
+      if (is_sequential) {
+        net_t seq = sequential_net(net_0, net_1);
+
+        std::cout << json::field("apply+not") << json::array_open << json::endl;
+
+        bdd_cache<Adapter> cache(nodes.size());
+
+        const auto [errcode, time] = construct_net_bdd(file_0, seq, cache, adapter);
+        if (errcode) { return errcode; }
+
+        std::cout << json::endl;
+        std::cout << json::array_close << json::comma << json::endl;
+
+        const auto [equal, time_reach] =
+          reachability(adapter, net_0, net_1, seq, cache, verify_networks);
+
+        std::cout << json::field("total time (ms)") << json::value(init_time + time + time_reach)
+                  << json::endl;
+
+        return equal ? 0 : -1;
+      }
+    }
+
+    // ============================================================================================
+    // Construct BDDs for the miter of both nets and compare them while doing so
+    if (miter) {
+      std::cout << json::field("structural hashing") << json::brace_open << json::endl;
+      std::cout << json::field("merged gates") << json::value(miter->merged_gates) << json::comma
+                << json::endl;
+      std::cout << json::field("equal outputs")
+                << json::value(net_0.outputs_in_order.size() - miter->pairs.size()) << json::comma
+                << json::endl;
+      std::cout << json::field("time (ms)") << json::value(strash_time) << json::endl;
+      std::cout << json::brace_close << json::comma << json::endl;
+      std::cout << json::endl;
+
+      std::cout << json::field("apply+not") << json::array_open << json::endl;
+
+      bdd_cache<Adapter> cache(nodes.size());
+      output_sweep<Adapter> sweep(net_0, net_1, *miter, cache, adapter);
+
+      sweep();
+      const auto [errcode, time] =
+        construct_net_bdd("miter", miter->net, cache, adapter, [&sweep]() { return sweep(); });
+
+      if (errcode) { return errcode; }
+
+      std::cout << json::endl;
+      std::cout << json::array_close << json::comma << json::endl;
+
+      std::cout << json::field("equal") << json::brace_open << json::endl;
+      std::cout << json::field("result") << json::value(sweep.equal()) << json::comma
+                << json::endl;
+      std::cout << json::field("compared outputs") << json::value(sweep.compared()) << json::endl;
+      std::cout << json::brace_close << json::comma << json::endl;
+
+      std::cout << json::field("total time (ms)")
+                << json::value(init_time + strash_time + time) << json::endl;
+
+      return sweep.equal() ? 0 : -1;
+    }
+
     // ============================================================================================
     // Construct BDD for first net
     time_duration total_time = 0;
 
     std::cout << json::field("apply+not") << json::array_open << json::endl;
 
-    bdd_cache<Adapter> cache_0;
+    bdd_cache<Adapter> cache(nodes.size());
 
     bool networks_equal = true;
 
-    const auto [errcode_0, time_0] = construct_net_bdd(file_0, net_0, cache_0, adapter);
+    const auto [errcode_0, time_0] = construct_net_bdd(file_0, net_0, cache, adapter);
 
     if (errcode_0) { return errcode_0; }
     total_time += time_0;
@@ -1269,9 +3438,7 @@ run_picotrav(int argc, char** argv)
     if (verify_networks) {
       std::cout << json::comma << json::endl;
 
-      bdd_cache<Adapter> cache_1;
-
-      const auto [errcode_1, time_1] = construct_net_bdd(file_1, net_1, cache_1, adapter);
+      const auto [errcode_1, time_1] = construct_net_bdd(file_1, net_1, cache, adapter);
 
       if (errcode_1) { return errcode_1; }
       total_time += time_1;
@@ -1280,7 +3447,7 @@ run_picotrav(int argc, char** argv)
       std::cout << json::array_close << json::comma << json::endl;
 
       const auto [verified, time_eq] =
-        verify_outputs<Adapter>(adapter, net_0, cache_0, net_1, cache_1);
+        verify_outputs<Adapter>(adapter, net_0, net_1, cache);
 
       networks_equal = verified;
       total_time += time_eq;
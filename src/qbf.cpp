@@ -11,6 +11,7 @@
 #include <queue>
 #include <string>
 #include <set>
+#include <tuple>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -1593,25 +1594,58 @@ obtain_var_order(const qcir& q, variable_order vo)
 
 // ========================================================================== //
 // Execution Order
+enum class execution_order
+{
+  INPUT,
+  LEVEL,
+  SETHI_ULLMAN,
+  MIN_CUT
+};
+
+std::string
+to_string(const execution_order& eo)
+{
+  switch (eo) {
+  case execution_order::INPUT: return "input";
+  case execution_order::LEVEL: return "level";
+  case execution_order::SETHI_ULLMAN: return "sethi-ullman";
+  case execution_order::MIN_CUT: return "min-cut";
+  }
+  return "?";
+}
 
 using exe_order = std::vector<int>;
 
-template <variable_order vo>
-exe_order
-obtain_exe_order(const qcir& q);
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Indices of the gates that are inputs to `g` (with duplicates).
+////////////////////////////////////////////////////////////////////////////////
+std::vector<int>
+exe_children(const qcir::gate& g)
+{
+  std::vector<int> res;
+  g.match(
+    [&res](const qcir::ngate& g) -> void {
+      for (const int lit : g.lit_list) { res.push_back(std::abs(lit)); }
+    },
+    [&res](const qcir::ite_gate& g) -> void {
+      for (const int lit : g.lits) { res.push_back(std::abs(lit)); }
+    },
+    [&res](const qcir::quant_gate& g) -> void { res.push_back(std::abs(g.lit)); },
+    [&res](const qcir::output_gate& g) -> void { res.push_back(std::abs(g.lit)); },
+    [](const auto& /*g*/) -> void { /* do nothing */ });
+  return res;
+}
 
-template <>
 exe_order
-obtain_exe_order<INPUT>(const qcir& q)
+obtain_exe_order__input(const qcir& q)
 {
   exe_order res = q.reachable();
   std::sort(res.begin(), res.end(), std::less<int>());
   return res;
 }
 
-template <>
 exe_order
-obtain_exe_order<LEVEL>(const qcir& q)
+obtain_exe_order__level(const qcir& q)
 {
   exe_order res = q.reachable();
   std::sort(res.begin(), res.end(), [&q](const int a, const int b) -> bool {
@@ -1621,16 +1655,197 @@ obtain_exe_order<LEVEL>(const qcir& q)
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Post-order depth-first traversal where the inputs of each gate are
+///        visited in descending order of their Sethi-Ullman number, i.e., the
+///        number of decision diagrams that need to be cached to compute them.
+///
+/// \details The Sethi-Ullman numbers are computed as if the circuit is a tree.
+///          Hence, shared gates are overapproximated.
+////////////////////////////////////////////////////////////////////////////////
+exe_order
+obtain_exe_order__sethi_ullman(const qcir& q)
+{
+  const exe_order input_order = obtain_exe_order__input(q);
+
+  // Sethi-Ullman numbers (bottom-up)
+  std::vector<size_t> need(q.end_idx(), 0u);
+  for (const int i : input_order) {
+    std::vector<size_t> children_need;
+    for (const int c : exe_children(q.at(i))) { children_need.push_back(need[c]); }
+    std::sort(children_need.begin(), children_need.end(), std::greater<size_t>());
+
+    need[i] = 1u;
+    for (size_t j = 0; j < children_need.size(); ++j) {
+      need[i] = std::max(need[i], children_need[j] + j);
+    }
+  }
+
+  // Post-order traversal (top-down)
+  exe_order res;
+  res.reserve(input_order.size());
+
+  std::vector<bool> visited(q.end_idx(), false);
+  std::vector<std::pair<int, bool>> dfs = { { q.root_idx(), false } };
+
+  while (!dfs.empty()) {
+    const auto [i, expanded] = dfs.back();
+    dfs.pop_back();
+
+    if (expanded) {
+      res.push_back(i);
+      continue;
+    }
+    if (visited[i]) { continue; }
+    visited[i] = true;
+
+    dfs.push_back({ i, true });
+
+    // Push in ascending order, such that the most expensive input is on top.
+    std::vector<int> children = exe_children(q.at(i));
+    std::stable_sort(children.begin(), children.end(), [&need](const int a, const int b) {
+      return need[a] < need[b];
+    });
+    for (const int c : children) {
+      if (!visited[c]) { dfs.push_back({ c, false }); }
+    }
+  }
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Greedy list scheduling that minimises the number of cached decision
+///        diagrams, i.e., the cut through the circuit.
+///
+/// \details Of all gates whose inputs already have been computed, the one that
+///          frees up the most cache entries is picked. Ties are broken in
+///          favour of the gate that most recently became ready (and initially
+///          in the order of a depth-first traversal). This keeps the schedule
+///          local to the current subcircuit.
+////////////////////////////////////////////////////////////////////////////////
+exe_order
+obtain_exe_order__min_cut(const qcir& q)
+{
+  const exe_order reachable = q.reachable();
+
+  // For each gate, its number of (unresolved) inputs, its number of unresolved
+  // references, and the gates referencing it.
+  std::vector<int> pending(q.end_idx(), 0);
+  std::vector<size_t> remaining(q.end_idx(), 0u);
+  std::vector<std::vector<int>> parents(q.end_idx());
+
+  for (const int i : reachable) {
+    for (const int c : exe_children(q.at(i))) {
+      pending[i] += 1;
+      remaining[c] += 1;
+      parents[c].push_back(i);
+    }
+  }
+
+  // Number of cache entries freed by resolving `i` now.
+  const auto freed = [&q, &remaining](const int i) -> int {
+    std::vector<int> children = exe_children(q.at(i));
+    std::sort(children.begin(), children.end());
+
+    int res = 0;
+    for (size_t j = 0; j < children.size();) {
+      size_t k = j;
+      while (k < children.size() && children[k] == children[j]) { ++k; }
+      // Constants are never removed from the cache.
+      if (2 < children[j] && remaining[children[j]] == k - j) { res += 1; }
+      j = k;
+    }
+    return res;
+  };
+
+  // Priority queue of gates that are ready: (freed, stamp, idx)
+  using entry_t = std::tuple<int, int, int>;
+  std::priority_queue<entry_t> ready;
+  std::vector<bool> done(q.end_idx(), false);
+
+  int stamp = -static_cast<int>(reachable.size());
+  for (auto it = reachable.crbegin(); it != reachable.crend(); ++it) {
+    if (pending[*it] == 0) { ready.push({ freed(*it), stamp, *it }); }
+    ++stamp;
+  }
+
+  exe_order res;
+  res.reserve(reachable.size());
+
+  while (!ready.empty()) {
+    const auto [i_freed, i_stamp, i] = ready.top();
+    ready.pop();
+
+    if (done[i]) { continue; }
+
+    // Reinsert outdated entries with their current priority
+    const int i_freed_now = freed(i);
+    if (i_freed != i_freed_now) {
+      ready.push({ i_freed_now, i_stamp, i });
+      continue;
+    }
+
+    done[i] = true;
+    res.push_back(i);
+
+    std::vector<int> children = exe_children(q.at(i));
+    for (const int c : children) { remaining[c] -= 1; }
+
+    // Some parents of the inputs may now free more entries.
+    std::sort(children.begin(), children.end());
+    children.erase(std::unique(children.begin(), children.end()), children.end());
+    for (const int c : children) {
+      if (remaining[c] == 0) { continue; }
+      for (const int p : parents[c]) {
+        if (!done[p] && pending[p] == 0) { ready.push({ freed(p), stamp++, p }); }
+      }
+    }
+
+    // Parents that are ready now.
+    for (const int p : parents[i]) { pending[p] -= 1; }
+    for (const int p : parents[i]) {
+      if (!done[p] && pending[p] == 0) { ready.push({ freed(p), stamp++, p }); }
+    }
+  }
+  assert(res.size() == reachable.size());
+  return res;
+}
+
 exe_order
-obtain_exe_order(const qcir& q, variable_order exe_order)
+obtain_exe_order(const qcir& q, execution_order eo)
 {
-  switch (exe_order) {
-  case INPUT: return obtain_exe_order<INPUT>(q);
+  switch (eo) {
+  case execution_order::LEVEL: return obtain_exe_order__level(q);
+  case execution_order::SETHI_ULLMAN: return obtain_exe_order__sethi_ullman(q);
+  case execution_order::MIN_CUT: return obtain_exe_order__min_cut(q);
   default:
-  case DF_LTR:
-  case DF_RTL:
-  case LEVEL: return obtain_exe_order<LEVEL>(q);
+  case execution_order::INPUT: return obtain_exe_order__input(q);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Largest number of decision diagrams cached at the same time, if the
+///        gates up to `max_q_idx` are resolved in the order `exo`.
+////////////////////////////////////////////////////////////////////////////////
+size_t
+exe_cache_max_size(const qcir& q, const exe_order& exo, const int max_q_idx)
+{
+  std::unordered_map<int, size_t> cache;
+  size_t res = 0u;
+
+  for (const int i : exo) {
+    if (i > max_q_idx) { continue; }
+
+    for (const int c : exe_children(q.at(i))) {
+      if (c <= 2) { continue; }
+      const auto c_it = cache.find(c);
+      assert(c_it != cache.end());
+      if (--c_it->second == 0) { cache.erase(c_it); }
+    }
+    cache.insert({ i, q.at(i).refcount });
+    res = std::max(res, cache.size());
   }
+  return res;
 }
 
 // ========================================================================== //
@@ -1698,7 +1913,10 @@ public:
 
 template <typename Adapter>
 solve_res
-solve(Adapter& adapter, qcir& q, const variable_order vo = variable_order::INPUT)
+solve(Adapter& adapter,
+      qcir& q,
+      const variable_order vo  = variable_order::INPUT,
+      const execution_order eo = execution_order::INPUT)
 {
   const time_point t_prep_before = now();
 
@@ -1708,9 +1926,7 @@ solve(Adapter& adapter, qcir& q, const variable_order vo = variable_order::INPUT
 
   const var_order_map vom = obtain_var_order(q, vo);
 
-  // TODO: Derive an execution order that minimises the cuts in the graph during
-  //       execution.
-  const exe_order exo = obtain_exe_order(q, variable_order::INPUT);
+  const exe_order exo = obtain_exe_order(q, eo);
 
   const time_point t_prep_after = now();
 
@@ -1718,6 +1934,22 @@ solve(Adapter& adapter, qcir& q, const variable_order vo = variable_order::INPUT
   std::cout << json::field("setup time (ms)")
             << json::value(duration_ms(t_prep_before, t_prep_after)) << json::comma << json::endl;
 
+#ifdef BDD_BENCHMARK_STATS
+  // Cache size of every execution order (to compare with the chosen one).
+  std::cout << json::field("max_cache (per order)") << json::brace_open << json::endl;
+  for (const execution_order other_eo : { execution_order::INPUT,
+                                          execution_order::LEVEL,
+                                          execution_order::SETHI_ULLMAN,
+                                          execution_order::MIN_CUT }) {
+    const exe_order other_exo = other_eo == eo ? exo : obtain_exe_order(q, other_eo);
+    std::cout << json::field(to_string(other_eo))
+              << json::value(exe_cache_max_size(q, other_exo, max_q_idx));
+    if (other_eo != execution_order::MIN_CUT) { std::cout << json::comma; }
+    std::cout << json::endl;
+  }
+  std::cout << json::brace_close << json::comma << json::endl;
+#endif // BDD_BENCHMARK_STATS
+
   // Set-up BDD computation cache
   std::unordered_map<int, std::pair<typename Adapter::dd_t, size_t>> cache;
 
@@ -1934,23 +2166,42 @@ solve(Adapter& adapter, qcir& q, const variable_order vo = variable_order::INPUT
 }
 
 // ========================================================================== //
-std::string file_path    = "";
-variable_order var_order = variable_order::INPUT;
+std::string file_path      = "";
+variable_order var_order   = variable_order::INPUT;
+execution_order exec_order = execution_order::INPUT;
 
 class parsing_policy
 {
 public:
   static constexpr std::string_view name = "QBF";
-  static constexpr std::string_view args = "f:o:";
+  static constexpr std::string_view args = "e:f:o:";
 
   static constexpr std::string_view help_text =
     "        -f PATH               Path to '.qcir' file\n"
-    "        -o ORDER     [input]  Variable Order to derive from circuit";
+    "        -o ORDER     [input]  Variable Order to derive from circuit\n"
+    "        -e ORDER     [input]  Order to resolve gates (input/level/sethi-ullman/min-cut)";
 
   static inline bool
   parse_input(const int c, const char* arg)
   {
     switch (c) {
+    case 'e': {
+      const std::string lower_arg = ascii_tolower(arg);
+
+      if (is_prefix(lower_arg, "input")) {
+        exec_order = execution_order::INPUT;
+      } else if (is_prefix(lower_arg, "level")) {
+        exec_order = execution_order::LEVEL;
+      } else if (is_prefix(lower_arg, "sethi-ullman") || lower_arg == "su") {
+        exec_order = execution_order::SETHI_ULLMAN;
+      } else if (is_prefix(lower_arg, "min-cut") || lower_arg == "cut") {
+        exec_order = execution_order::MIN_CUT;
+      } else {
+        std::cerr << "Undefined execution order: " << arg << "\n";
+        return true;
+      }
+      return false;
+    }
     case 'f': {
       if (!std::filesystem::exists(arg)) {
         std::cerr << "File '" << arg << "' does not exist\n";
@@ -2004,9 +2255,11 @@ run_qbf(int argc, char** argv)
     std::cout << json::field("size") << json::value(q.size()) << json::comma << json::endl;
     std::cout << json::field("variable order") << json::value(to_string(var_order)) << json::comma
               << json::endl;
+    std::cout << json::field("execution order") << json::value(to_string(exec_order))
+              << json::comma << json::endl;
     std::cout << json::endl;
 
-    const auto [sat_res, witness, stats] = solve(adapter, q, var_order);
+    const auto [sat_res, witness, stats] = solve(adapter, q, var_order, exec_order);
 
     std::cout << json::field("max_cache") << json::value(stats.cache.max_size) << json::comma
               << json::endl;
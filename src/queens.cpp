@@ -13,6 +13,7 @@
 #include "common/chrono.h"
 #include "common/input.h"
 #include "common/json.h"
+#include "common/satcount.h"
 
 #ifdef BDD_BENCHMARK_STATS
 size_t largest_bdd = 0;
@@ -256,7 +257,7 @@ run_queens(int argc, char** argv)
   // =========================================================================
   // Initialise package manager
   return run<Adapter>("queens", N * N, [&](Adapter& adapter) {
-    uint64_t solutions;
+    big_uint solutions;
 
     std::cout << json::field("N") << json::value(N) << json::comma << json::endl;
     std::cout << json::endl << json::flush;
@@ -292,12 +293,21 @@ run_queens(int argc, char** argv)
     std::cout << json::field("satcount") << json::brace_open << json::endl << json::flush;
 
     const time_point t3 = now();
-    solutions           = adapter.satcount(res);
+    solutions           = adapter.satcount_exact(res);
     const time_point t4 = now();
 
     const time_duration counting_time = duration_ms(t3, t4);
 
     std::cout << json::field("result") << json::value(solutions) << json::comma << json::endl;
+    std::cout << json::field("approximate") << json::value(!Adapter::exact_satcount)
+              << json::comma << json::endl;
+    std::cout << json::field("result (log2)");
+    if (solutions.is_zero()) {
+      std::cout << json::nil;
+    } else {
+      std::cout << json::value(solutions.log2());
+    }
+    std::cout << json::comma << json::endl;
     std::cout << json::field("time (ms)") << json::value(counting_time) << json::endl;
     std::cout << json::brace_close << json::comma << json::endl << json::flush;
 
@@ -306,7 +316,11 @@ run_queens(int argc, char** argv)
               << json::value(init_time + construction_time + counting_time) << json::endl
               << json::flush;
 
-    if (rows() == cols() && cols() < size(expected) && solutions != expected[cols()]) { return -1; }
+    // Without an exact model count, the result may be rounded or have overflowed.
+    if (Adapter::exact_satcount && rows() == cols() && cols() < size(expected)
+        && solutions != expected[cols()]) {
+      return -1;
+    }
     return 0;
   });
 }
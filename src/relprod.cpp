@@ -6,6 +6,7 @@
 #include <vector>
 
 // Other
+#include <algorithm>
 #include <stdexcept>
 
 #include "common/adapter.h"
@@ -17,13 +18,15 @@
 //                                        INPUT PARSING                                           //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::string relation_path = "";
-std::string states_path   = "";
+std::vector<std::string> relation_paths;
+std::string states_path = "";
 
 enum operand
 {
   NEXT,
-  PREV
+  PREV,
+  REACH_NEXT,
+  REACH_PREV
 };
 
 std::string
@@ -32,27 +35,106 @@ to_string(const operand& oper)
   switch (oper) {
   case operand::NEXT: return "next";
   case operand::PREV: return "prev";
+  case operand::REACH_NEXT: return "reach-next";
+  case operand::REACH_PREV: return "reach-prev";
   default: return "?";
   }
 }
 
 operand oper = operand::NEXT;
 
+/// \brief Whether the relation is traversed forwards.
+inline bool
+is_forwards(const operand& oper)
+{
+  return oper == operand::NEXT || oper == operand::REACH_NEXT;
+}
+
+/// \brief Whether a fixpoint (rather than a single image) is to be computed.
+inline bool
+is_reachability(const operand& oper)
+{
+  return oper == operand::REACH_NEXT || oper == operand::REACH_PREV;
+}
+
+enum reach_strategy
+{
+  FRONTIER,
+  SET
+};
+
+std::string
+to_string(const reach_strategy& s)
+{
+  switch (s) {
+  case reach_strategy::FRONTIER: return "frontier";
+  case reach_strategy::SET: return "set";
+  default: return "?";
+  }
+}
+
+reach_strategy strategy = reach_strategy::FRONTIER;
+
+enum partition_order
+{
+  INPUT,
+  IWLS95
+};
+
+std::string
+to_string(const partition_order& o)
+{
+  switch (o) {
+  case partition_order::INPUT: return "input";
+  case partition_order::IWLS95: return "iwls95";
+  default: return "?";
+  }
+}
+
+partition_order order = partition_order::IWLS95;
+
+size_t cluster_threshold = 0;
+
 class parsing_policy
 {
 public:
   static constexpr std::string_view name = "RelProd";
-  static constexpr std::string_view args = "o:r:s:";
+  static constexpr std::string_view args = "c:i:o:p:r:s:";
 
   static constexpr std::string_view help_text =
-    "        -o OPER     [next]    Relational Product to use (next/prev)\n"
-    "        -r PATH               Path to '._dd' file for relation\n"
+    "        -c NODES    [0]       Cluster partitions up to this size (0 = no clustering)\n"
+    "        -i ITER     [front]   Image of frontier or all states in fixpoints (frontier/set)\n"
+    "        -o OPER     [next]    Relational Product to use (next/prev/reach-next/reach-prev)\n"
+    "        -p ORDER    [iwls95]  Order of relation partitions (input/iwls95)\n"
+    "        -r PATH               Path to '._dd' file for relation (partition)\n"
     "        -s PATH               Path to '._dd' file for states\n";
 
   static inline bool
   parse_input(const int c, const char* arg)
   {
     switch (c) {
+    case 'c': {
+      const int val = std::stoi(arg);
+      if (val < 0) {
+        std::cerr << "Cluster threshold must be non-negative\n";
+        return true;
+      }
+      cluster_threshold = val;
+      return false;
+    }
+    case 'i': {
+      const std::string lower_arg = ascii_tolower(arg);
+
+      if (is_prefix(lower_arg, "frontier") || is_prefix(lower_arg, "bfs")) {
+        strategy = reach_strategy::FRONTIER;
+      } else if (is_prefix(lower_arg, "set") || is_prefix(lower_arg, "full")) {
+        strategy = reach_strategy::SET;
+      } else {
+        std::cerr << "Undefined iteration strategy " << arg << "\n";
+        return true;
+      }
+      return false;
+    }
     case 'o': {
       const std::string lower_arg = ascii_tolower(arg);
 
@@ -60,18 +142,35 @@ public:
         oper = operand::NEXT;
       } else if (is_prefix(lower_arg, "prev") || is_prefix(lower_arg, "relprev")) {
         oper = operand::PREV;
+      } else if (is_prefix(lower_arg, "reach-next") || is_prefix(lower_arg, "reach_next")) {
+        oper = operand::REACH_NEXT;
+      } else if (is_prefix(lower_arg, "reach-prev") || is_prefix(lower_arg, "reach_prev")) {
+        oper = operand::REACH_PREV;
       } else {
         std::cerr << "Undefined operation " << arg << "\n";
         return true;
       }
       return false;
     }
+    case 'p': {
+      const std::string lower_arg = ascii_tolower(arg);
+
+      if (is_prefix(lower_arg, "input")) {
+        order = partition_order::INPUT;
+      } else if (is_prefix(lower_arg, "iwls95")) {
+        order = partition_order::IWLS95;
+      } else {
+        std::cerr << "Undefined partition order " << arg << "\n";
+        return true;
+      }
+      return false;
+    }
     case 'r': {
       if (!std::filesystem::exists(arg)) {
         std::cerr << "File '" << arg << "' does not exist\n";
         return true;
       }
-      relation_path = arg;
+      relation_paths.push_back(arg);
       return false;
     }
     case 's': {
@@ -99,6 +198,388 @@ build_support(Adapter& adapter, const int/*varcount*/)
   return adapter.cube([](int) { return true; });
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                       Partitioned Relations with Early Quantification                          //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Characteristic vector of the variables a BDD depends on.
+using support_t = std::vector<bool>;
+
+/// \brief Obtain the (remapped) support of a 'lib-bdd' BDD.
+support_t
+support_of(const lib_bdd::bdd& f, const lib_bdd::var_map& vm, const int varcount)
+{
+  support_t out(varcount, false);
+  for (size_t i = 2; i < f.size(); ++i) {
+    const auto var = vm.find(f.at(i).level());
+    if (var != vm.end()) { out.at(var->second) = true; }
+  }
+  return out;
+}
+
+/// \brief Whether a variable is quantified by the chosen relational product, i.e. the unprimed
+///        (even) variables for `next` and the primed (odd) variables for `prev`.
+inline bool
+is_quantified(const int x)
+{
+  return (x % 2) == (is_forwards(oper) ? 0 : 1);
+}
+
+/// \brief Order in which to conjoin the relation partitions.
+///
+/// \details For `iwls95`, the order is derived greedily as in Ranjan et al. (1995): the next
+///          partition is the one where the largest fraction of its quantifiable variables are
+///          mentioned by no other remaining partition, i.e. can be quantified immediately. Ties are
+///          broken by the fewest newly introduced variables and then by the input order.
+std::vector<size_t>
+order_partitions(const std::vector<support_t>& supports, const int varcount)
+{
+  std::vector<size_t> out;
+  out.reserve(supports.size());
+
+  if (order == partition_order::INPUT) {
+    for (size_t i = 0; i < supports.size(); ++i) { out.push_back(i); }
+    return out;
+  }
+
+  // Number of remaining partitions that depend on each variable
+  std::vector<size_t> occurrences(varcount, 0u);
+  for (const support_t& s : supports) {
+    for (int x = 0; x < varcount; ++x) { occurrences[x] += s[x]; }
+  }
+
+  std::vector<bool> introduced(varcount, false);
+  std::vector<bool> done(supports.size(), false);
+
+  while (out.size() < supports.size()) {
+    size_t best_idx     = supports.size();
+    double best_benefit = -1.0;
+    int best_fresh      = 0;
+
+    for (size_t i = 0; i < supports.size(); ++i) {
+      if (done[i]) { continue; }
+
+      int quantifiable = 0;
+      int local        = 0;
+      int fresh        = 0;
+
+      for (int x = 0; x < varcount; ++x) {
+        if (!supports[i][x]) { continue; }
+
+        if (is_quantified(x)) {
+          quantifiable += 1;
+          local += occurrences[x] == 1;
+        } else {
+          fresh += !introduced[x];
+        }
+      }
+
+      const double benefit = quantifiable == 0 ? 0.0 : static_cast<double>(local) / quantifiable;
+
+      if (best_benefit < benefit || (best_benefit == benefit && fresh < best_fresh)) {
+        best_idx     = i;
+        best_benefit = benefit;
+        best_fresh   = fresh;
+      }
+    }
+    assert(best_idx < supports.size());
+
+    done[best_idx] = true;
+    out.push_back(best_idx);
+
+    for (int x = 0; x < varcount; ++x) {
+      if (!supports[best_idx][x]) { continue; }
+      occurrences[x] -= 1;
+      introduced[x] = true;
+    }
+  }
+  return out;
+}
+
+/// \brief Relation partitions after ordering and clustering together with the variables to
+///        quantify after each cluster has been conjoined.
+template <typename Adapter>
+struct partitioned_relation
+{
+  std::vector<typename Adapter::dd_t> clusters;
+  std::vector<std::vector<size_t>> members;
+  std::vector<std::vector<int>> quant_vars;
+};
+
+/// \brief Order and cluster the relation partitions and derive the quantification schedule.
+///
+/// \details Each variable is quantified right after the last cluster that depends on it. For
+///          `prev`, the states are only added in the very last step, since they first have to be
+///          shifted onto the primed variables; hence, only the primed variables outside of the
+///          states' support are quantified early.
+///
+/// \returns The partitioned relation and the time spent (ms).
+template <typename Adapter>
+std::pair<partitioned_relation<Adapter>, size_t>
+schedule(Adapter& adapter,
+         std::vector<typename Adapter::dd_t>& partitions,
+         const std::vector<support_t>& supports,
+         const support_t& states_support,
+         const int varcount)
+{
+  using dd_t = typename Adapter::dd_t;
+
+  partitioned_relation<Adapter> out;
+
+  if (partitions.size() == 1) {
+    out.clusters.push_back(partitions.front());
+    out.members.push_back({ 0u });
+    out.quant_vars.push_back({});
+
+    partitions.clear();
+    return { out, 0u };
+  }
+
+  std::cout << json::field("schedule") << json::brace_open << json::endl;
+  std::cout << json::field("partitions") << json::value(partitions.size()) << json::comma
+            << json::endl;
+  std::cout << json::field("order") << json::value(to_string(order)) << json::comma << json::endl;
+  std::cout << json::field("cluster threshold") << json::value(cluster_threshold) << json::comma
+            << json::endl
+            << json::flush;
+
+  const time_point t_schedule_before = now();
+
+  // ===============================================================================================
+  // Order and cluster partitions
+  std::vector<support_t> cluster_supports;
+
+  for (const size_t i : order_partitions(supports, varcount)) {
+    if (!out.clusters.empty() && 0 < cluster_threshold) {
+      const dd_t merged = adapter.apply_and(out.clusters.back(), partitions.at(i));
+
+      if (adapter.nodecount(merged) <= cluster_threshold) {
+        out.clusters.back() = merged;
+        for (int x = 0; x < varcount; ++x) {
+          cluster_supports.back()[x] = cluster_supports.back()[x] || supports.at(i)[x];
+        }
+        out.members.back().push_back(i);
+        continue;
+      }
+    }
+    out.clusters.push_back(partitions.at(i));
+    cluster_supports.push_back(supports.at(i));
+    out.members.push_back({ i });
+  }
+
+  // Free up memory
+  partitions.clear();
+
+  // ===============================================================================================
+  // Quantification schedule
+  out.quant_vars.resize(out.clusters.size());
+  {
+    std::vector<bool> needed(varcount, false);
+
+    if (!is_forwards(oper)) {
+      for (int x = 0; x + 1 < varcount; x += 2) { needed[x + 1] = states_support[x]; }
+    }
+
+    for (size_t c = out.clusters.size(); 0 < c--;) {
+      for (int x = 0; x < varcount; ++x) {
+        const bool in_cluster =
+          cluster_supports[c][x] || (c == 0 && is_forwards(oper) && states_support[x]);
+
+        if (is_quantified(x) && in_cluster && !needed[x]) { out.quant_vars[c].push_back(x); }
+      }
+      for (int x = 0; x < varcount; ++x) { needed[x] = needed[x] || cluster_supports[c][x]; }
+    }
+  }
+
+  const time_point t_schedule_after = now();
+
+  const size_t schedule_time = duration_ms(t_schedule_before, t_schedule_after);
+
+  std::cout << json::field("clusters") << json::value(out.clusters.size()) << json::comma
+            << json::endl;
+  std::cout << json::field("time (ms)") << json::value(schedule_time) << json::endl;
+  std::cout << json::brace_close << json::comma << json::endl;
+
+  return { out, schedule_time };
+}
+
+/// \brief Relational Product of the states with the conjunction of all relation partitions.
+///
+/// \details With a single cluster, this is the BDD package's own `relnext`/`relprev`. Otherwise,
+///          the clusters are conjoined one-by-one with the states (and-exists) following the
+///          given quantification schedule. The last step is again left to `relnext`/`relprev`
+///          which quantifies the remaining variables and shifts the result.
+///
+/// \param print_steps Whether to output the size and time of each step.
+///
+/// \returns The result and the time spent (ms).
+template <typename Adapter>
+std::pair<typename Adapter::dd_t, size_t>
+image(Adapter& adapter,
+      const typename Adapter::dd_t& states,
+      const partitioned_relation<Adapter>& relation,
+      const typename Adapter::dd_t& support,
+      const int varcount,
+      const bool print_steps)
+{
+  using dd_t = typename Adapter::dd_t;
+
+  if (relation.clusters.size() == 1) {
+    const time_point t_before = now();
+    const dd_t result = is_forwards(oper)
+      ? adapter.relnext(states, relation.clusters.front(), support)
+      : adapter.relprev(states, relation.clusters.front(), support);
+    const time_point t_after = now();
+
+    return { result, duration_ms(t_before, t_after) };
+  }
+
+  dd_t acc          = is_forwards(oper) ? states : adapter.top();
+  size_t quantified = 0;
+  size_t image_time = 0;
+
+  if (print_steps) {
+    std::cout << json::field("steps") << json::array_open << json::endl << json::flush;
+  }
+
+  for (size_t c = 0; c < relation.clusters.size(); ++c) {
+    const bool is_last = c + 1 == relation.clusters.size();
+
+    const time_point t_step_before = now();
+    if (!is_last) {
+      acc = adapter.exists(adapter.apply_and(acc, relation.clusters[c]),
+                           relation.quant_vars[c].crbegin(),
+                           relation.quant_vars[c].crend());
+    } else if (is_forwards(oper)) {
+      acc = adapter.relnext(adapter.top(), adapter.apply_and(acc, relation.clusters[c]), support);
+    } else {
+      acc = adapter.relprev(states, adapter.apply_and(acc, relation.clusters[c]), support);
+    }
+    const time_point t_step_after = now();
+
+    const size_t step_time = duration_ms(t_step_before, t_step_after);
+    image_time += step_time;
+
+    if (!print_steps) { continue; }
+
+    const size_t quantified_now =
+      is_last ? varcount / 2 - quantified : relation.quant_vars[c].size();
+    quantified += quantified_now;
+
+    std::cout << json::indent << json::brace_open << json::endl;
+    std::cout << json::field("partitions") << "[";
+    for (size_t m = 0; m < relation.members[c].size(); ++m) {
+      std::cout << (m == 0 ? "" : ", ") << relation.members[c][m];
+    }
+    std::cout << "]" << json::comma << json::endl;
+    std::cout << json::field("quantified") << json::value(quantified_now) << json::comma
+              << json::endl;
+    std::cout << json::field("size (nodes)") << json::value(adapter.nodecount(acc)) << json::comma
+              << json::endl;
+    std::cout << json::field("time (ms)") << json::value(step_time) << json::endl;
+    std::cout << json::brace_close << (is_last ? "" : ",") << json::endl << json::flush;
+  }
+
+  if (print_steps) { std::cout << json::array_close << json::comma << json::endl; }
+
+  return { acc, image_time };
+}
+
+/// \brief Least fixpoint of the image, starting from the given states.
+///
+/// \details With the `frontier` strategy, only the newly found states are used in each image
+///          computation (BFS). With the `set` strategy, the image of all states found so far is
+///          computed instead.
+///
+/// \returns The set of reachable states and the time spent (ms).
+template <typename Adapter>
+std::pair<typename Adapter::dd_t, size_t>
+reachability(Adapter& adapter,
+             const typename Adapter::dd_t& states,
+             const partitioned_relation<Adapter>& relation,
+             const typename Adapter::dd_t& support,
+             const int varcount)
+{
+  using dd_t = typename Adapter::dd_t;
+
+  std::cout << json::field("strategy") << json::value(to_string(strategy)) << json::comma
+            << json::endl;
+  std::cout << json::field("iterations") << json::array_open << json::endl << json::flush;
+
+  dd_t reachable    = states;
+  dd_t frontier     = states;
+  size_t reach_time = 0;
+
+  for (size_t i = 1; true; ++i) {
+    const time_point t_iter_before = now();
+
+    const dd_t img = image(adapter,
+                           strategy == reach_strategy::FRONTIER ? frontier : reachable,
+                           relation,
+                           support,
+                           varcount,
+                           false)
+                       .first;
+
+    frontier  = adapter.apply_diff(img, reachable);
+    reachable = adapter.apply_or(reachable, frontier);
+
+    const time_point t_iter_after = now();
+
+    const size_t iter_time = duration_ms(t_iter_before, t_iter_after);
+    reach_time += iter_time;
+
+    const bool is_last = frontier == adapter.bot();
+
+    std::cout << json::indent << json::brace_open << json::endl;
+    std::cout << json::field("iteration") << json::value(i) << json::comma << json::endl;
+    std::cout << json::field("image (nodes)") << json::value(adapter.nodecount(img))
+              << json::comma << json::endl;
+    std::cout << json::field("frontier (nodes)") << json::value(adapter.nodecount(frontier))
+              << json::comma << json::endl;
+    std::cout << json::field("reachable (nodes)") << json::value(adapter.nodecount(reachable))
+              << json::comma << json::endl;
+    std::cout << json::field("time (ms)") << json::value(iter_time) << json::endl;
+    std::cout << json::brace_close << (is_last ? "" : ",") << json::endl << json::flush;
+
+    if (is_last) { break; }
+  }
+
+  std::cout << json::array_close << json::comma << json::endl;
+
+  return { reachable, reach_time };
+}
+
+/// \brief Run the chosen operation on the states and the (partitioned) relation.
+///
+/// \returns The result and the time spent (ms).
+template <typename Adapter>
+std::pair<typename Adapter::dd_t, size_t>
+relprod(Adapter& adapter,
+        const typename Adapter::dd_t& states,
+        const support_t& states_support,
+        std::vector<typename Adapter::dd_t>& partitions,
+        const std::vector<support_t>& supports,
+        const typename Adapter::dd_t& support,
+        const int varcount)
+{
+  std::cout << json::field("operand") << json::value(to_string(oper)) << json::comma
+            << json::endl;
+
+  // The (intermediate) states during reachability may depend on any variable.
+  const support_t schedule_support =
+    is_reachability(oper) ? support_t(varcount, true) : states_support;
+
+  const auto [relation, schedule_time] =
+    schedule(adapter, partitions, supports, schedule_support, varcount);
+
+  const auto [result, relprod_time] = is_reachability(oper)
+    ? reachability(adapter, states, relation, support, varcount)
+    : image(adapter, states, relation, support, varcount, 1 < relation.clusters.size());
+
+  return { result, schedule_time + relprod_time };
+}
+
 template <typename Adapter>
 int
 run_relprod(int argc, char** argv)
@@ -106,7 +587,7 @@ run_relprod(int argc, char** argv)
   const bool should_exit = parse_input<parsing_policy>(argc, argv);
   if (should_exit) { return -1; }
 
-  if (relation_path == "") {
+  if (relation_paths.empty()) {
     std::cerr << "Path for relation missing\n";
     return -1;
   }
@@ -117,42 +598,77 @@ run_relprod(int argc, char** argv)
 
   // =============================================================================================
   // Load 'lib-bdd' files
-  lib_bdd::bdd libbdd_relation = lib_bdd::deserialize(relation_path);
-  lib_bdd::bdd libbdd_states   = lib_bdd::deserialize(states_path);
+  std::vector<lib_bdd::bdd> libbdd_relations;
+  for (const std::string& path : relation_paths) {
+    libbdd_relations.push_back(lib_bdd::deserialize(path));
+  }
+  lib_bdd::bdd libbdd_states = lib_bdd::deserialize(states_path);
+
+  lib_bdd::var_map vm;
+  {
+    std::vector<lib_bdd::bdd> all_bdds = libbdd_relations;
+    all_bdds.push_back(libbdd_states);
+    vm = lib_bdd::remap_vars(all_bdds);
+  }
+
+  const int varcount = vm.size();
 
-  lib_bdd::var_map vm = lib_bdd::remap_vars({ libbdd_relation, libbdd_states });
+  std::vector<support_t> relation_supports;
+  for (const lib_bdd::bdd& f : libbdd_relations) {
+    relation_supports.push_back(support_of(f, vm, varcount));
+  }
+  const support_t states_support = support_of(libbdd_states, vm, varcount);
 
   // =============================================================================================
   // Initialize BDD package
-  return run<Adapter>("relprod", vm.size(), [&](Adapter& adapter) {
+  return run<Adapter>("relprod", varcount, [&](Adapter& adapter) {
     size_t total_time = 0;
 
     // =============================================================================================
     // Reconstruct DDs
-    typename Adapter::dd_t relation = adapter.bot();
-    {
+    std::vector<typename Adapter::dd_t> relations;
+
+    if (relation_paths.size() == 1) {
       std::cout << json::field("relation") << json::brace_open << json::endl;
+    } else {
+      std::cout << json::field("relations") << json::array_open << json::endl;
+    }
+
+    for (size_t i = 0; i < relation_paths.size(); ++i) {
+      if (1 < relation_paths.size()) {
+        std::cout << json::indent << json::brace_open << json::endl;
+      }
 
-      std::cout << json::field("path") << json::value(relation_path) << json::comma << json::endl;
-      lib_bdd::print_json(lib_bdd::stats(libbdd_relation), std::cout);
+      std::cout << json::field("path") << json::value(relation_paths[i]) << json::comma
+                << json::endl;
+      lib_bdd::print_json(lib_bdd::stats(libbdd_relations[i]), std::cout);
       std::cout << json::comma << json::endl;
 
       const time_point t_rebuild_before = now();
-      relation                          = reconstruct(adapter, std::move(libbdd_relation), vm);
-      const time_point t_rebuild_after  = now();
+      relations.push_back(reconstruct(adapter, std::move(libbdd_relations[i]), vm));
+      const time_point t_rebuild_after = now();
 
       const size_t rebuild_time = duration_ms(t_rebuild_before, t_rebuild_after);
       total_time += rebuild_time;
 
       // Free up memory
-      libbdd_relation.clear();
-      libbdd_relation.shrink_to_fit();
+      libbdd_relations[i].clear();
+      libbdd_relations[i].shrink_to_fit();
 
-      std::cout << json::field("satcount") << json::value(adapter.satcount(relation)) << json::comma
-                << json::endl;
+      std::cout << json::field("satcount") << json::value(adapter.satcount(relations.back()))
+                << json::comma << json::endl;
       std::cout << json::field("time (ms)") << json::value(rebuild_time) << json::endl;
 
+      if (1 < relation_paths.size()) {
+        std::cout << json::brace_close << (i + 1 < relation_paths.size() ? "," : "")
+                  << json::endl;
+      }
+    }
+
+    if (relation_paths.size() == 1) {
       std::cout << json::brace_close << json::comma << json::endl;
+    } else {
+      std::cout << json::array_close << json::comma << json::endl;
     }
 
     typename Adapter::dd_t states = adapter.bot();
@@ -174,7 +690,7 @@ run_relprod(int argc, char** argv)
       libbdd_states.clear();
       libbdd_states.shrink_to_fit();
 
-      std::cout << json::field("satcount") << json::value(adapter.satcount(states, vm.size() / 2))
+      std::cout << json::field("satcount") << json::value(adapter.satcount(states, varcount / 2))
                 << json::comma << json::endl;
       std::cout << json::field("time (ms)") << json::value(rebuild_time) << json::endl;
 
@@ -188,7 +704,7 @@ run_relprod(int argc, char** argv)
       std::cout << json::field("support") << json::brace_open << json::endl;
 
       const time_point t_build_before = now();
-      support                         = build_support(adapter, vm.size());
+      support                         = build_support(adapter, varcount);
       const time_point t_build_after  = now();
 
       const size_t build_time = duration_ms(t_build_before, t_build_after);
@@ -207,25 +723,15 @@ run_relprod(int argc, char** argv)
 
     // =============================================================================================
     // Relational Product
-    typename Adapter::dd_t result = adapter.bot();
-
     std::cout << json::field("relprod") << json::brace_open << json::endl << json::flush;
 
-    const time_point t_relprod_before = now();
-    switch (oper) {
-    case operand::NEXT: result = adapter.relnext(states, relation, support); break;
-    case operand::PREV: result = adapter.relprev(states, relation, support); break;
-    }
-    const time_point t_relprod_after = now();
-
-    const size_t relprod_time = duration_ms(t_relprod_before, t_relprod_after);
+    const auto [result, relprod_time] =
+      relprod(adapter, states, states_support, relations, relation_supports, support, varcount);
     total_time += relprod_time;
 
-    std::cout << json::field("operand") << json::value(to_string(oper)) << json::comma
-              << json::endl;
     std::cout << json::field("size (nodes)") << adapter.nodecount(result) << json::comma
               << json::endl;
-    std::cout << json::field("satcount") << adapter.satcount(result, vm.size() / 2) << json::comma
+    std::cout << json::field("satcount") << adapter.satcount(result, varcount / 2) << json::comma
               << json::endl;
     std::cout << json::field("time (ms)") << relprod_time << json::endl;
 
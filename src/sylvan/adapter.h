@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <iostream>
@@ -5,6 +6,7 @@
 #include <string_view>
 
 #include "../common/adapter.h"
+#include "../common/satcount.h"
 
 #include <sylvan.h>
 #include <sylvan_table.h>
@@ -80,6 +82,11 @@ public:
 
   static constexpr bool complement_edges = true;
 
+  static constexpr bool thread_safe      = true;
+  static constexpr bool supports_rename  = true;
+  static constexpr bool supports_relnext = true;
+  static constexpr bool exact_satcount   = true;
+
 public:
   typedef sylvan::Bdd dd_t;
   typedef sylvan::Bdd build_node_t;
@@ -121,6 +128,16 @@ public:
     return RUN(lace_lambda, &f);
   }
 
+  /// Evaluate `f` and `g` in parallel, where `f` is spawned as a LACE task
+  /// (that may be stolen by another worker)
+  inline void
+  par(const std::function<int()>& f, const std::function<int()>& g)
+  {
+    SPAWN(lace_lambda, &f);
+    g();
+    SYNC(lace_lambda);
+  }
+
   // BDD Operations
 public:
   inline sylvan::Bdd
@@ -265,6 +282,19 @@ public:
     return states.RelPrev(rel, rel_support);
   }
 
+  inline sylvan::Bdd
+  rename(const sylvan::Bdd& f, const std::function<int(int)>& m)
+  {
+    assert(is_variable_permutation(_varcount, m));
+
+    sylvan::BddMap map;
+    for (int x = 0; x < _varcount; ++x) {
+      if (m(x) != x) { map.put(x, sylvan::Bdd::bddVar(m(x))); }
+    }
+
+    return f.Compose(map);
+  }
+
   inline uint64_t
   nodecount(const sylvan::Bdd& f)
   {
@@ -283,6 +313,73 @@ public:
     return f.SatCount(vc);
   }
 
+  inline big_uint
+  satcount_exact(const sylvan::Bdd& f)
+  {
+    return this->satcount_exact(f, this->_varcount);
+  }
+
+  inline big_uint
+  satcount_exact(const sylvan::Bdd& f, const size_t vc)
+  {
+    struct view
+    {
+      using edge_type                        = sylvan::BDD;
+      static constexpr bool complement_edges = true;
+
+      sylvan::BDD
+      regular(const sylvan::BDD e) const
+      {
+        return e & ~sylvan_complement;
+      }
+
+      bool
+      is_complemented(const sylvan::BDD e) const
+      {
+        return (e & sylvan_complement) != 0u;
+      }
+
+      bool
+      is_terminal(const sylvan::BDD e) const
+      {
+        return e == sylvan_false;
+      }
+
+      bool
+      terminal_value(const sylvan::BDD /*e*/) const
+      {
+        // The only regular terminal is `false`; `true` is its complement.
+        return false;
+      }
+
+      sylvan::BDDVAR
+      level(const sylvan::BDD e) const
+      {
+        return sylvan::sylvan_var(e);
+      }
+
+      sylvan::BDD
+      low(const sylvan::BDD e) const
+      {
+        return sylvan::sylvan_low(e);
+      }
+
+      sylvan::BDD
+      high(const sylvan::BDD e) const
+      {
+        return sylvan::sylvan_high(e);
+      }
+
+      uint64_t
+      id(const sylvan::BDD e) const
+      {
+        return e;
+      }
+    };
+
+    return bdd_satcount_exact(view(), f.GetBDD(), this->_varcount, vc);
+  }
+
   inline sylvan::Bdd
   satone(const sylvan::Bdd& f)
   {